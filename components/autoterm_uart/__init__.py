@@ -1,21 +1,51 @@
 import esphome.config_validation as cv
 import esphome.codegen as cg
-from esphome import const
+from esphome import automation, const
+from esphome.core import CORE
 import esphome.components.uart as uart
 import esphome.components.sensor as sensor
 import esphome.components.text_sensor as text_sensor
 import esphome.components.number as number
 import esphome.components.climate as climate
 import esphome.components.select as select
+import esphome.components.time as time_
+import esphome.components.web_server_base as web_server_base
 
 DEPENDENCIES = ["sensor", "text_sensor", "number", "climate"]
-AUTO_LOAD = ["sensor", "text_sensor", "number", "climate", "select"]
+
+
+def AUTO_LOAD():
+    # socket nur mitziehen, wenn der UDP-Export konfiguriert ist
+    auto_load = ["sensor", "text_sensor", "number", "climate", "select"]
+    conf = (getattr(CORE, "raw_config", None) or {}).get("autoterm_uart")
+    confs = conf if isinstance(conf, list) else [conf]
+    if any(isinstance(c, dict) and CONF_TELEMETRY in c for c in confs):
+        auto_load.append("socket")
+    return auto_load
+
 
 autoterm_ns = cg.esphome_ns.namespace("autoterm_uart")
 AutotermFanLevelNumber = autoterm_ns.class_("AutotermFanLevelNumber", number.Number)
 AutotermUART = autoterm_ns.class_("AutotermUART", cg.Component)
 AutotermClimate = autoterm_ns.class_("AutotermClimate", climate.Climate)
 AutotermTempSourceSelect = autoterm_ns.class_("AutotermTempSourceSelect", select.Select)
+LabelLanguage = autoterm_ns.enum("LabelLanguage", is_class=True)
+PreheatScheduleAction = autoterm_ns.class_("PreheatScheduleAction", automation.Action)
+PreheatCancelAction = autoterm_ns.class_("PreheatCancelAction", automation.Action)
+BenchmarkAction = autoterm_ns.class_("BenchmarkAction", automation.Action)
+FaultHistoryDumpAction = autoterm_ns.class_("FaultHistoryDumpAction", automation.Action)
+FaultHistoryClearAction = autoterm_ns.class_("FaultHistoryClearAction", automation.Action)
+PhaseChangeTrigger = autoterm_ns.class_("PhaseChangeTrigger", automation.Trigger.template(cg.uint16, cg.uint16))
+IgnitionFailedTrigger = autoterm_ns.class_("IgnitionFailedTrigger", automation.Trigger.template(cg.uint16))
+FrameRef = cg.std_vector.template(cg.uint8).operator("ref").operator("const")
+FrameTrigger = autoterm_ns.class_("FrameTrigger", automation.Trigger.template(cg.bool_, cg.uint8, FrameRef))
+FrameTriggerDirection = FrameTrigger.enum("Direction")
+DisplayConnectedTrigger = autoterm_ns.class_("DisplayConnectedTrigger", automation.Trigger.template())
+DisplayLostTrigger = autoterm_ns.class_("DisplayLostTrigger", automation.Trigger.template())
+ThermostatCycleTrigger = autoterm_ns.class_("ThermostatCycleTrigger", automation.Trigger.template(cg.bool_, cg.float_))
+BatteryGovernorTrigger = autoterm_ns.class_(
+    "BatteryGovernorTrigger", automation.Trigger.template(cg.std_string, cg.float_)
+)
 
 CONF_CLIMATE = "climate"
 CONF_DEFAULT_LEVEL = "default_level"
@@ -23,24 +53,307 @@ CONF_DEFAULT_TEMPERATURE = "default_temperature"
 CONF_DEFAULT_TEMP_SENSOR = "default_temp_sensor"
 CONF_THERMOSTAT_HYS_ON = "thermostat_hysteresis_on"
 CONF_THERMOSTAT_HYS_OFF = "thermostat_hysteresis_off"
+CONF_LANGUAGE = "language"
+CONF_MIN_PUBLISH_INTERVAL = "min_publish_interval"
+CONF_SUPPRESSED_PUBLISHES = "suppressed_publishes"
 CONF_PANEL_TEMP_OVERRIDE = "panel_temp_override"
 CONF_PANEL_TEMP_OVERRIDE_SENSOR = "sensor"
+CONF_MIN_DELTA = "min_delta"
+CONF_KEEPALIVE_INTERVAL = "keepalive_interval"
 CONF_TEMP_SOURCE_SELECT = "temperature_source_select"
+CONF_PREHEAT = "preheat"
+CONF_LEVEL = "level"
+CONF_DEFAULT_WARMUP_RATE = "default_warmup_rate"
+CONF_STARTUP_TIME = "startup_time"
+CONF_MAX_LEAD_TIME = "max_lead_time"
+CONF_HOUR = "hour"
+CONF_MINUTE = "minute"
+CONF_TARGET_TEMPERATURE = "target_temperature"
+CONF_ON_PHASE_CHANGE = "on_phase_change"
+CONF_ON_IGNITION_FAILED = "on_ignition_failed"
+CONF_ON_FRAME = "on_frame"
+CONF_ON_DISPLAY_CONNECTED = "on_display_connected"
+CONF_ON_DISPLAY_LOST = "on_display_lost"
+CONF_ON_THERMOSTAT_CYCLE = "on_thermostat_cycle"
+CONF_DIRECTION = "direction"
+CONF_RX_TASK = "rx_task"
+CONF_RX_TASK_PRIORITY = "rx_task_priority"
+CONF_LATENCY = "latency"
+CONF_BUS_HEALTH = "bus_health"
+CONF_FRAME_LENGTHS = "frame_lengths"
+CONF_UNKNOWN_MAX_LENGTH = "unknown_max_length"
+CONF_COMMANDS = "commands"
+CONF_LENGTH = "length"
+
+# Gerätekennung (Byte 1): 0x03 = Frame vom Bedienteil, 0x04 = Frame der Heizung
+FRAME_DEVICES = {
+    "display": 0x03,
+    "heater": 0x04,
+}
+CONF_WINDOW = "window"
+
+# Reihenfolge wie BusCounter in autoterm_uart.h
+BUS_COUNTERS = [
+    "frames_ok",
+    "crc_errors",
+    "resyncs",
+    "aborted_frames",
+    "stray_bytes",
+    "injected_frames",
+    "rewritten_frames",
+]
+BUS_DIRECTIONS = ["display", "heater"]
+CONF_LOOP_TIME_MAX = "loop_time_max"
+CONF_BYTES_PER_LOOP_MAX = "bytes_per_loop_max"
+
+# (direction, stat) wie LatencyStat in autoterm_uart.h
+LATENCY_SENSORS = {
+    "display_to_heater_p50": (0, 0),
+    "display_to_heater_p99": (0, 1),
+    "display_to_heater_max": (0, 2),
+    "heater_to_display_p50": (1, 0),
+    "heater_to_display_p99": (1, 1),
+    "heater_to_display_max": (1, 2),
+}
+CONF_COMMAND = "command"
+CONF_PANEL_EMULATION = "panel_emulation"
+CONF_HEATER_MODEL = "heater_model"
+CONF_FAULT_HISTORY = "fault_history"
+CONF_ITERATIONS = "iterations"
+CONF_DECODE_CACHE = "decode_cache"
+CONF_REFRESH_INTERVAL = "refresh_interval"
+CONF_HIT_RATE = "hit_rate"
+CONF_COMMAND_WINDOW = "command_window"
+CONF_COALESCED_COMMANDS = "coalesced_commands"
+CONF_RECONCILE = "reconcile"
+CONF_SETTLE_TIME = "settle_time"
+CONF_MAX_RETRIES = "max_retries"
+CONF_TELEMETRY = "telemetry"
+CONF_BATCH_SIZE = "batch_size"
+CONF_FLUSH_INTERVAL = "flush_interval"
+CONF_DROPPED = "dropped"
+CONF_METRICS = "metrics"
+CONF_BATTERY_GOVERNOR = "battery_governor"
+CONF_ON_BATTERY_GOVERNOR = "on_battery_governor"
+CONF_REDUCE_BELOW = "reduce_below"
+CONF_BLOCK_IGNITION_BELOW = "block_ignition_below"
+CONF_STOP_BELOW = "stop_below"
+CONF_RESUME_ABOVE = "resume_above"
+CONF_FILTER_TIME = "filter_time"
+CONF_TREND_TIME = "trend_time"
+CONF_LOOKAHEAD = "lookahead"
+CONF_STEP_INTERVAL = "step_interval"
+CONF_MIN_LEVEL = "min_level"
+CONF_FILTERED_VOLTAGE = "filtered_voltage"
+CONF_VOLTAGE_TREND = "voltage_trend"
+CONF_LAST_FAULT = "last_fault"
+CONF_FAULT_COUNT = "fault_count"
+CONF_SLOT_INTERVAL = "slot_interval"
+CONF_SWITCHOVER_LATENCY = "switchover_latency"
+CONF_TAKEOVERS = "takeovers"
+
+FRAME_DIRECTIONS = {
+    "any": FrameTriggerDirection.DIRECTION_ANY,
+    "display": FrameTriggerDirection.DIRECTION_DISPLAY,
+    "heater": FrameTriggerDirection.DIRECTION_HEATER,
+}
 
 TEMP_SOURCE_OPTIONS = ["Intern", "Panel", "Extern", "Home Assistant"]
 
+
+LABEL_LANGUAGES = {
+    "de": LabelLanguage.DE,
+    "en": LabelLanguage.EN,
+}
+
 CLIMATE_SCHEMA = climate.climate_schema(AutotermClimate).extend({
     cv.Optional(CONF_DEFAULT_LEVEL, default=4): cv.int_range(min=0, max=9),
     cv.Optional(CONF_DEFAULT_TEMPERATURE, default=20.0): cv.temperature,
     cv.Optional(CONF_DEFAULT_TEMP_SENSOR, default=2): cv.int_range(min=1, max=4),
     cv.Optional(CONF_THERMOSTAT_HYS_ON, default=2.0): cv.float_range(min=1.0, max=5.0),
     cv.Optional(CONF_THERMOSTAT_HYS_OFF, default=1.0): cv.float_range(min=0.0, max=2.0),
+    cv.Optional(CONF_LANGUAGE, default="de"): cv.enum(LABEL_LANGUAGES, lower=True),
+    cv.Optional(CONF_MIN_PUBLISH_INTERVAL, default="1s"): cv.positive_time_period_milliseconds,
+    cv.Optional(CONF_SUPPRESSED_PUBLISHES): sensor.sensor_schema(
+        accuracy_decimals=0, state_class=const.STATE_CLASS_TOTAL_INCREASING,
+        entity_category=const.ENTITY_CATEGORY_DIAGNOSTIC, icon="mdi:publish-off",
+    ),
+})
+
+PREHEAT_SCHEMA = cv.Schema({
+    cv.Required(const.CONF_TIME_ID): cv.use_id(time_.RealTimeClock),
+    cv.Optional(CONF_LEVEL, default=8): cv.int_range(min=0, max=9),
+    cv.Optional(CONF_DEFAULT_TEMPERATURE, default=20.0): cv.temperature,
+    cv.Optional(CONF_DEFAULT_WARMUP_RATE, default=0.3): cv.float_range(min=0.01, max=5.0),
+    cv.Optional(CONF_STARTUP_TIME, default="5min"): cv.positive_time_period_seconds,
+    cv.Optional(CONF_MAX_LEAD_TIME, default="3h"): cv.positive_time_period_seconds,
+    cv.Optional(const.CONF_STATUS): text_sensor.text_sensor_schema(icon="mdi:clock-start"),
 })
 
-CONFIG_SCHEMA = cv.Schema({
+LATENCY_SCHEMA = cv.Schema({
+    cv.Optional(const.CONF_UPDATE_INTERVAL, default="60s"): cv.positive_time_period_milliseconds,
+    **{
+        cv.Optional(key): sensor.sensor_schema(unit_of_measurement="ms", icon="mdi:timer-sand", accuracy_decimals=2)
+        for key in LATENCY_SENSORS
+    },
+    cv.Optional(CONF_LOOP_TIME_MAX): sensor.sensor_schema(
+        unit_of_measurement="ms", icon="mdi:timer-sand", accuracy_decimals=2
+    ),
+    cv.Optional(CONF_BYTES_PER_LOOP_MAX): sensor.sensor_schema(unit_of_measurement="B", icon="mdi:counter"),
+})
+
+BUS_DIRECTION_SCHEMA = cv.Schema({
+    **{
+        cv.Optional(key): sensor.sensor_schema(
+            icon="mdi:counter",
+            accuracy_decimals=0,
+            state_class=const.STATE_CLASS_TOTAL_INCREASING,
+        )
+        for key in BUS_COUNTERS
+    },
+    **{
+        cv.Optional(f"{key}_rate"): sensor.sensor_schema(
+            unit_of_measurement="1/min",
+            icon="mdi:speedometer",
+            accuracy_decimals=1,
+            state_class=const.STATE_CLASS_MEASUREMENT,
+        )
+        for key in BUS_COUNTERS
+    },
+})
+
+BUS_HEALTH_SCHEMA = cv.Schema({
+    cv.Optional(CONF_WINDOW, default="60s"): cv.positive_time_period_milliseconds,
+    **{cv.Optional(direction): BUS_DIRECTION_SCHEMA for direction in BUS_DIRECTIONS},
+})
+
+FRAME_LENGTHS_SCHEMA = cv.Schema({
+    cv.Optional(CONF_UNKNOWN_MAX_LENGTH, default=32): cv.int_range(min=0, max=48),
+    cv.Optional(CONF_COMMANDS, default=[]): cv.ensure_list(cv.Schema({
+        cv.Required(CONF_DIRECTION): cv.enum(FRAME_DEVICES, lower=True),
+        cv.Required(CONF_COMMAND): cv.hex_uint8_t,
+        cv.Required(CONF_LENGTH): cv.int_range(min=0, max=48),
+    })),
+})
+
+PANEL_EMULATION_SCHEMA = cv.Schema({
+    cv.Optional(CONF_SLOT_INTERVAL, default="2s"): cv.All(
+        cv.positive_time_period_milliseconds,
+        cv.Range(min=cv.TimePeriod(milliseconds=500), max=cv.TimePeriod(seconds=10)),
+    ),
+    cv.Optional(CONF_SWITCHOVER_LATENCY): sensor.sensor_schema(
+        unit_of_measurement="ms", accuracy_decimals=0,
+        entity_category=const.ENTITY_CATEGORY_DIAGNOSTIC, icon="mdi:swap-horizontal",
+    ),
+    cv.Optional(CONF_TAKEOVERS): sensor.sensor_schema(
+        accuracy_decimals=0, state_class=const.STATE_CLASS_TOTAL_INCREASING,
+        entity_category=const.ENTITY_CATEGORY_DIAGNOSTIC, icon="mdi:counter",
+    ),
+})
+
+FAULT_HISTORY_SCHEMA = cv.Schema({
+    cv.Optional(const.CONF_TIME_ID): cv.use_id(time_.RealTimeClock),
+    cv.Optional(CONF_LAST_FAULT): text_sensor.text_sensor_schema(
+        icon="mdi:alert-circle", entity_category=const.ENTITY_CATEGORY_DIAGNOSTIC
+    ),
+    cv.Optional(CONF_FAULT_COUNT): sensor.sensor_schema(
+        accuracy_decimals=0, state_class=const.STATE_CLASS_TOTAL_INCREASING,
+        entity_category=const.ENTITY_CATEGORY_DIAGNOSTIC, icon="mdi:alert-circle-check",
+    ),
+})
+
+DECODE_CACHE_SCHEMA = cv.Schema({
+    cv.Optional(const.CONF_ENABLED, default=True): cv.boolean,
+    cv.Optional(CONF_REFRESH_INTERVAL, default="30s"): cv.positive_time_period_milliseconds,
+    cv.Optional(CONF_HIT_RATE): sensor.sensor_schema(
+        unit_of_measurement="%", accuracy_decimals=1,
+        entity_category=const.ENTITY_CATEGORY_DIAGNOSTIC, icon="mdi:cached",
+    ),
+})
+
+RECONCILE_SCHEMA = cv.Schema({
+    cv.Optional(const.CONF_ENABLED, default=True): cv.boolean,
+    cv.Optional(CONF_SETTLE_TIME, default="10s"): cv.All(
+        cv.positive_time_period_milliseconds,
+        cv.Range(min=cv.TimePeriod(seconds=4), max=cv.TimePeriod(minutes=5)),
+    ),
+    cv.Optional(CONF_MAX_RETRIES, default=3): cv.int_range(min=0, max=10),
+})
+
+TELEMETRY_SCHEMA = cv.Schema({
+    cv.Required(const.CONF_HOST): cv.ipv4address,
+    cv.Required(const.CONF_PORT): cv.port,
+    # 8 Byte Kopf + 36 Byte je Datensatz, 32 Datensätze bleiben unter einer Ethernet-MTU
+    cv.Optional(CONF_BATCH_SIZE, default=8): cv.int_range(min=1, max=32),
+    cv.Optional(CONF_FLUSH_INTERVAL, default="5s"): cv.positive_time_period_milliseconds,
+    cv.Optional(CONF_DROPPED): sensor.sensor_schema(
+        accuracy_decimals=0, state_class=const.STATE_CLASS_TOTAL_INCREASING,
+        entity_category=const.ENTITY_CATEGORY_DIAGNOSTIC, icon="mdi:lan-disconnect",
+    ),
+})
+
+METRICS_SCHEMA = cv.Schema({
+    cv.GenerateID(web_server_base.CONF_WEB_SERVER_BASE_ID): cv.use_id(web_server_base.WebServerBase),
+    cv.Optional(const.CONF_PATH, default="/metrics"): cv.string_strict,
+    cv.Optional(const.CONF_UPDATE_INTERVAL, default="10s"): cv.All(
+        cv.positive_time_period_milliseconds,
+        cv.Range(min=cv.TimePeriod(seconds=1), max=cv.TimePeriod(minutes=5)),
+    ),
+})
+
+def validate_battery_thresholds(config):
+    if not (config[CONF_STOP_BELOW] < config[CONF_BLOCK_IGNITION_BELOW] <= config[CONF_REDUCE_BELOW]
+            < config[CONF_RESUME_ABOVE]):
+        raise cv.Invalid(
+            f"Schwellen müssen {CONF_STOP_BELOW} < {CONF_BLOCK_IGNITION_BELOW} <= {CONF_REDUCE_BELOW} "
+            f"< {CONF_RESUME_ABOVE} erfüllen"
+        )
+    return config
+
+
+BATTERY_GOVERNOR_SCHEMA = cv.All(cv.Schema({
+    cv.Optional(CONF_REDUCE_BELOW, default="12.2V"): cv.voltage,
+    cv.Optional(CONF_BLOCK_IGNITION_BELOW, default="12.0V"): cv.voltage,
+    cv.Optional(CONF_STOP_BELOW, default="11.6V"): cv.voltage,
+    cv.Optional(CONF_RESUME_ABOVE, default="12.8V"): cv.voltage,
+    cv.Optional(CONF_FILTER_TIME, default="60s"): cv.positive_time_period_milliseconds,
+    cv.Optional(CONF_TREND_TIME, default="15min"): cv.positive_time_period_milliseconds,
+    cv.Optional(CONF_LOOKAHEAD, default="10min"): cv.positive_time_period_milliseconds,
+    cv.Optional(CONF_STEP_INTERVAL, default="2min"): cv.positive_time_period_milliseconds,
+    cv.Optional(CONF_MIN_LEVEL, default=0): cv.int_range(min=0, max=9),
+    cv.Optional(const.CONF_STATE): text_sensor.text_sensor_schema(icon="mdi:car-battery"),
+    cv.Optional(CONF_FILTERED_VOLTAGE): sensor.sensor_schema(
+        unit_of_measurement="V", accuracy_decimals=2, device_class=const.DEVICE_CLASS_VOLTAGE,
+        state_class=const.STATE_CLASS_MEASUREMENT,
+    ),
+    cv.Optional(CONF_VOLTAGE_TREND): sensor.sensor_schema(
+        unit_of_measurement="V/h", accuracy_decimals=2, state_class=const.STATE_CLASS_MEASUREMENT,
+        icon="mdi:trending-down",
+    ),
+}), validate_battery_thresholds)
+
+
+def validate_config(config):
+    override = config.get(CONF_PANEL_TEMP_OVERRIDE)
+    if override is not None and CONF_PANEL_EMULATION in config and CONF_KEEPALIVE_INTERVAL in override:
+        # Mit Emulation gibt der 0x11-Slot den Takt vor, ein eigener Keepalive würde den Zyklus stören
+        raise cv.Invalid(
+            f"{CONF_KEEPALIVE_INTERVAL} wird mit {CONF_PANEL_EMULATION} nicht verwendet: "
+            f"der Override geht bei Änderung im nächsten Slot und sonst im 0x11-Slot raus"
+        )
+    if CONF_ON_BATTERY_GOVERNOR in config and CONF_BATTERY_GOVERNOR not in config:
+        raise cv.Invalid(f"{CONF_ON_BATTERY_GOVERNOR} benötigt den Block {CONF_BATTERY_GOVERNOR}")
+    if CONF_COALESCED_COMMANDS in config and config[CONF_COMMAND_WINDOW].total_milliseconds == 0:
+        raise cv.Invalid(f"{CONF_COALESCED_COMMANDS} benötigt ein {CONF_COMMAND_WINDOW} größer 0")
+    return config
+
+
+CONFIG_SCHEMA = cv.All(cv.Schema({
     cv.GenerateID(): cv.declare_id(AutotermUART),
     cv.Required("uart_display_id"): cv.use_id(uart.UARTComponent),
     cv.Required("uart_heater_id"): cv.use_id(uart.UARTComponent),
+    cv.Optional(CONF_RX_TASK, default=False): cv.boolean,
+    cv.Optional(CONF_RX_TASK_PRIORITY, default=18): cv.int_range(min=1, max=24),
 
     cv.Optional("internal_temp"): sensor.sensor_schema(unit_of_measurement="°C", icon="mdi:thermometer"),
     cv.Optional("external_temp"): sensor.sensor_schema(unit_of_measurement="°C", icon="mdi:thermometer"),
@@ -67,16 +380,67 @@ CONFIG_SCHEMA = cv.Schema({
     ),
 
     cv.Optional("status_text"): text_sensor.text_sensor_schema(icon="mdi:information"),
+    cv.Optional(CONF_HEATER_MODEL): text_sensor.text_sensor_schema(
+        icon="mdi:chip", entity_category=const.ENTITY_CATEGORY_DIAGNOSTIC
+    ),
 
     cv.Optional("fan_level"): number.number_schema(class_=AutotermFanLevelNumber, icon="mdi:fan-speed-1"),
 
     cv.Optional(CONF_CLIMATE): CLIMATE_SCHEMA,
     cv.Optional(CONF_PANEL_TEMP_OVERRIDE): cv.Schema({
         cv.Required(CONF_PANEL_TEMP_OVERRIDE_SENSOR): cv.use_id(sensor.Sensor),
+        cv.Optional(CONF_MIN_DELTA, default=0.5): cv.positive_float,
+        cv.Optional(CONF_KEEPALIVE_INTERVAL): cv.All(
+            cv.positive_time_period_milliseconds,
+            cv.Range(min=cv.TimePeriod(seconds=1), max=cv.TimePeriod(seconds=60)),
+        ),
     }),
     cv.Optional(CONF_TEMP_SOURCE_SELECT): select.select_schema(class_=AutotermTempSourceSelect, icon="mdi:thermometer-probe"),
+    cv.Optional(CONF_PREHEAT): PREHEAT_SCHEMA,
+    cv.Optional(CONF_PANEL_EMULATION): PANEL_EMULATION_SCHEMA,
+    cv.Optional(CONF_FAULT_HISTORY): FAULT_HISTORY_SCHEMA,
+    cv.Optional(CONF_DECODE_CACHE): DECODE_CACHE_SCHEMA,
+    cv.Optional(CONF_RECONCILE): RECONCILE_SCHEMA,
+    cv.Optional(CONF_TELEMETRY): TELEMETRY_SCHEMA,
+    cv.Optional(CONF_METRICS): METRICS_SCHEMA,
+    cv.Optional(CONF_BATTERY_GOVERNOR): BATTERY_GOVERNOR_SCHEMA,
+    cv.Optional(CONF_COMMAND_WINDOW, default="250ms"): cv.All(
+        cv.positive_time_period_milliseconds,
+        cv.Range(max=cv.TimePeriod(seconds=2)),
+    ),
+    cv.Optional(CONF_COALESCED_COMMANDS): sensor.sensor_schema(
+        accuracy_decimals=0, state_class=const.STATE_CLASS_TOTAL_INCREASING,
+        entity_category=const.ENTITY_CATEGORY_DIAGNOSTIC, icon="mdi:call-merge",
+    ),
+    cv.Optional(CONF_LATENCY): LATENCY_SCHEMA,
+    cv.Optional(CONF_BUS_HEALTH): BUS_HEALTH_SCHEMA,
+    cv.Optional(CONF_FRAME_LENGTHS): FRAME_LENGTHS_SCHEMA,
 
-})
+    cv.Optional(CONF_ON_PHASE_CHANGE): automation.validate_automation({
+        cv.GenerateID(const.CONF_TRIGGER_ID): cv.declare_id(PhaseChangeTrigger),
+    }),
+    cv.Optional(CONF_ON_IGNITION_FAILED): automation.validate_automation({
+        cv.GenerateID(const.CONF_TRIGGER_ID): cv.declare_id(IgnitionFailedTrigger),
+    }),
+    cv.Optional(CONF_ON_FRAME): automation.validate_automation({
+        cv.GenerateID(const.CONF_TRIGGER_ID): cv.declare_id(FrameTrigger),
+        cv.Optional(CONF_DIRECTION, default="any"): cv.enum(FRAME_DIRECTIONS, lower=True),
+        cv.Optional(CONF_COMMAND): cv.hex_uint8_t,
+    }),
+    cv.Optional(CONF_ON_DISPLAY_CONNECTED): automation.validate_automation({
+        cv.GenerateID(const.CONF_TRIGGER_ID): cv.declare_id(DisplayConnectedTrigger),
+    }),
+    cv.Optional(CONF_ON_DISPLAY_LOST): automation.validate_automation({
+        cv.GenerateID(const.CONF_TRIGGER_ID): cv.declare_id(DisplayLostTrigger),
+    }),
+    cv.Optional(CONF_ON_THERMOSTAT_CYCLE): automation.validate_automation({
+        cv.GenerateID(const.CONF_TRIGGER_ID): cv.declare_id(ThermostatCycleTrigger),
+    }),
+    cv.Optional(CONF_ON_BATTERY_GOVERNOR): automation.validate_automation({
+        cv.GenerateID(const.CONF_TRIGGER_ID): cv.declare_id(BatteryGovernorTrigger),
+    }),
+
+}), validate_config)
 
 
 async def to_code(config):
@@ -87,6 +451,59 @@ async def to_code(config):
     cg.add(var.set_uart_display(disp))
     cg.add(var.set_uart_heater(heat))
 
+    # Nur konfigurierte Teilsysteme einkompilieren
+    if CONF_CLIMATE in config or CONF_PREHEAT in config or CONF_ON_THERMOSTAT_CYCLE in config:
+        cg.add_define("USE_AUTOTERM_THERMOSTAT")
+    if "runtime_hours" in config or "session_runtime" in config:
+        cg.add_define("USE_AUTOTERM_RUNTIME")
+    if CONF_PANEL_TEMP_OVERRIDE in config:
+        cg.add_define("USE_AUTOTERM_PANEL_OVERRIDE")
+    if CONF_TEMP_SOURCE_SELECT in config:
+        cg.add_define("USE_AUTOTERM_TEMP_SOURCE_SELECT")
+    if "status_text" in config:
+        cg.add_define("USE_AUTOTERM_STATUS_TEXT")
+    if CONF_PANEL_EMULATION in config:
+        cg.add_define("USE_AUTOTERM_PANEL_EMULATION")
+    if CONF_FAULT_HISTORY in config:
+        cg.add_define("USE_AUTOTERM_FAULT_HISTORY")
+    if CONF_TELEMETRY in config:
+        cg.add_define("USE_AUTOTERM_TELEMETRY")
+    if CONF_METRICS in config:
+        cg.add_define("USE_AUTOTERM_METRICS")
+    if CONF_BATTERY_GOVERNOR in config:
+        cg.add_define("USE_AUTOTERM_BATTERY_GOVERNOR")
+    if CONF_PREHEAT in config:
+        cg.add_define("USE_AUTOTERM_PREHEAT")
+    if CONF_BUS_HEALTH in config:
+        cg.add_define("USE_AUTOTERM_BUS_HEALTH")
+    if CONF_DECODE_CACHE in config and config[CONF_DECODE_CACHE][const.CONF_ENABLED]:
+        cg.add_define("USE_AUTOTERM_DECODE_CACHE")
+    if CONF_RECONCILE in config and config[CONF_RECONCILE][const.CONF_ENABLED]:
+        cg.add_define("USE_AUTOTERM_RECONCILE")
+    if CONF_HEATER_MODEL in config or CONF_TELEMETRY in config:
+        # Die Telemetrie überträgt die Gerätekennung aus der Versionsabfrage mit
+        cg.add_define("USE_AUTOTERM_HEATER_MODEL")
+    if config[CONF_COMMAND_WINDOW].total_milliseconds > 0:
+        cg.add_define("USE_AUTOTERM_COMMAND_WINDOW")
+    for key, define in [
+        (CONF_ON_PHASE_CHANGE, "USE_AUTOTERM_ON_PHASE_CHANGE"),
+        (CONF_ON_IGNITION_FAILED, "USE_AUTOTERM_ON_IGNITION_FAILED"),
+        (CONF_ON_FRAME, "USE_AUTOTERM_ON_FRAME"),
+        (CONF_ON_DISPLAY_CONNECTED, "USE_AUTOTERM_ON_DISPLAY_CONNECTED"),
+        (CONF_ON_DISPLAY_LOST, "USE_AUTOTERM_ON_DISPLAY_LOST"),
+        (CONF_ON_THERMOSTAT_CYCLE, "USE_AUTOTERM_ON_THERMOSTAT_CYCLE"),
+    ]:
+        if key in config:
+            cg.add_define(define)
+    if config[CONF_RX_TASK]:
+        cg.add(var.set_rx_task(True))
+        cg.add(var.set_rx_task_priority(config[CONF_RX_TASK_PRIORITY]))
+    if CONF_FRAME_LENGTHS in config:
+        lengths_conf = config[CONF_FRAME_LENGTHS]
+        cg.add(var.set_unknown_command_max_length(lengths_conf[CONF_UNKNOWN_MAX_LENGTH]))
+        for rule in lengths_conf[CONF_COMMANDS]:
+            cg.add(var.add_frame_length(rule[CONF_DIRECTION], rule[CONF_COMMAND], rule[CONF_LENGTH]))
+
     for key, setter in [
         ("internal_temp", "set_internal_temp_sensor"),
         ("external_temp", "set_external_temp_sensor"),
@@ -106,6 +523,7 @@ async def to_code(config):
 
     for key, setter in [
         ("status_text", "set_status_text_sensor"),
+        (CONF_HEATER_MODEL, "set_heater_model_sensor"),
     ]:
         if key in config:
             txt = await text_sensor.new_text_sensor(config[key])
@@ -125,6 +543,11 @@ async def to_code(config):
         clim = cg.new_Pvariable(climate_conf[const.CONF_ID])
        # await cg.register_component(clim, climate_conf)
         await climate.register_climate(clim, climate_conf)
+        cg.add(clim.set_label_language(climate_conf[CONF_LANGUAGE]))
+        cg.add(clim.set_min_publish_interval(climate_conf[CONF_MIN_PUBLISH_INTERVAL]))
+        if CONF_SUPPRESSED_PUBLISHES in climate_conf:
+            sens = await sensor.new_sensor(climate_conf[CONF_SUPPRESSED_PUBLISHES])
+            cg.add(clim.set_suppressed_publish_sensor(sens))
         cg.add(clim.set_default_level(climate_conf[CONF_DEFAULT_LEVEL]))
         cg.add(clim.set_default_temperature(climate_conf[CONF_DEFAULT_TEMPERATURE]))
         cg.add(clim.set_default_temp_sensor(climate_conf[CONF_DEFAULT_TEMP_SENSOR]))
@@ -137,9 +560,237 @@ async def to_code(config):
     if CONF_PANEL_TEMP_OVERRIDE in config:
         override_conf = config[CONF_PANEL_TEMP_OVERRIDE]
         src = await cg.get_variable(override_conf[CONF_PANEL_TEMP_OVERRIDE_SENSOR])
+        cg.add(var.set_panel_temp_override_min_delta(override_conf[CONF_MIN_DELTA]))
+        if CONF_KEEPALIVE_INTERVAL in override_conf:
+            cg.add(var.set_panel_temp_override_keepalive(override_conf[CONF_KEEPALIVE_INTERVAL]))
         cg.add(var.set_panel_temp_override_sensor(src))
 
     if CONF_TEMP_SOURCE_SELECT in config:
         select_conf = config[CONF_TEMP_SOURCE_SELECT]
         sel = await select.new_select(select_conf, options=TEMP_SOURCE_OPTIONS)
         cg.add(var.set_temp_source_select(sel))
+
+    if CONF_PREHEAT in config:
+        preheat_conf = config[CONF_PREHEAT]
+        clock = await cg.get_variable(preheat_conf[const.CONF_TIME_ID])
+        cg.add(var.set_preheat_clock(clock))
+        cg.add(var.set_preheat_level(preheat_conf[CONF_LEVEL]))
+        cg.add(var.set_preheat_default_target(preheat_conf[CONF_DEFAULT_TEMPERATURE]))
+        cg.add(var.set_preheat_default_rate(preheat_conf[CONF_DEFAULT_WARMUP_RATE]))
+        cg.add(var.set_preheat_startup_time(preheat_conf[CONF_STARTUP_TIME].total_seconds))
+        cg.add(var.set_preheat_max_lead_time(preheat_conf[CONF_MAX_LEAD_TIME].total_seconds))
+        if const.CONF_STATUS in preheat_conf:
+            txt = await text_sensor.new_text_sensor(preheat_conf[const.CONF_STATUS])
+            cg.add(var.set_preheat_status_sensor(txt))
+
+    if CONF_PANEL_EMULATION in config:
+        emulation_conf = config[CONF_PANEL_EMULATION]
+        cg.add(var.set_panel_slot_interval(emulation_conf[CONF_SLOT_INTERVAL]))
+        if CONF_SWITCHOVER_LATENCY in emulation_conf:
+            sens = await sensor.new_sensor(emulation_conf[CONF_SWITCHOVER_LATENCY])
+            cg.add(var.set_panel_switchover_sensor(sens))
+        if CONF_TAKEOVERS in emulation_conf:
+            sens = await sensor.new_sensor(emulation_conf[CONF_TAKEOVERS])
+            cg.add(var.set_panel_takeover_sensor(sens))
+
+    if config[CONF_COMMAND_WINDOW].total_milliseconds > 0:
+        cg.add(var.set_command_window(config[CONF_COMMAND_WINDOW]))
+        if CONF_COALESCED_COMMANDS in config:
+            sens = await sensor.new_sensor(config[CONF_COALESCED_COMMANDS])
+            cg.add(var.set_commands_coalesced_sensor(sens))
+
+    if CONF_RECONCILE in config and config[CONF_RECONCILE][const.CONF_ENABLED]:
+        reconcile_conf = config[CONF_RECONCILE]
+        cg.add(var.set_reconcile_settle_time(reconcile_conf[CONF_SETTLE_TIME]))
+        cg.add(var.set_reconcile_max_retries(reconcile_conf[CONF_MAX_RETRIES]))
+
+    if CONF_TELEMETRY in config:
+        telemetry_conf = config[CONF_TELEMETRY]
+        cg.add(var.set_telemetry_target(str(telemetry_conf[const.CONF_HOST]), telemetry_conf[const.CONF_PORT]))
+        cg.add(var.set_telemetry_batch_size(telemetry_conf[CONF_BATCH_SIZE]))
+        cg.add(var.set_telemetry_flush_interval(telemetry_conf[CONF_FLUSH_INTERVAL]))
+        if CONF_DROPPED in telemetry_conf:
+            sens = await sensor.new_sensor(telemetry_conf[CONF_DROPPED])
+            cg.add(var.set_telemetry_dropped_sensor(sens))
+
+    if CONF_METRICS in config:
+        metrics_conf = config[CONF_METRICS]
+        server = await cg.get_variable(metrics_conf[web_server_base.CONF_WEB_SERVER_BASE_ID])
+        cg.add(var.set_metrics_server(server, metrics_conf[const.CONF_PATH]))
+        cg.add(var.set_metrics_update_interval(metrics_conf[const.CONF_UPDATE_INTERVAL]))
+
+    if CONF_BATTERY_GOVERNOR in config:
+        battery_conf = config[CONF_BATTERY_GOVERNOR]
+        cg.add(var.set_battery_thresholds(
+            battery_conf[CONF_REDUCE_BELOW], battery_conf[CONF_BLOCK_IGNITION_BELOW],
+            battery_conf[CONF_STOP_BELOW], battery_conf[CONF_RESUME_ABOVE],
+        ))
+        cg.add(var.set_battery_filter_time(battery_conf[CONF_FILTER_TIME]))
+        cg.add(var.set_battery_trend_time(battery_conf[CONF_TREND_TIME]))
+        cg.add(var.set_battery_lookahead(battery_conf[CONF_LOOKAHEAD]))
+        cg.add(var.set_battery_step_interval(battery_conf[CONF_STEP_INTERVAL]))
+        cg.add(var.set_battery_min_level(battery_conf[CONF_MIN_LEVEL]))
+        if const.CONF_STATE in battery_conf:
+            txt = await text_sensor.new_text_sensor(battery_conf[const.CONF_STATE])
+            cg.add(var.set_battery_state_sensor(txt))
+        if CONF_FILTERED_VOLTAGE in battery_conf:
+            sens = await sensor.new_sensor(battery_conf[CONF_FILTERED_VOLTAGE])
+            cg.add(var.set_battery_filtered_voltage_sensor(sens))
+        if CONF_VOLTAGE_TREND in battery_conf:
+            sens = await sensor.new_sensor(battery_conf[CONF_VOLTAGE_TREND])
+            cg.add(var.set_battery_trend_sensor(sens))
+
+    if CONF_DECODE_CACHE in config and config[CONF_DECODE_CACHE][const.CONF_ENABLED]:
+        cache_conf = config[CONF_DECODE_CACHE]
+        cg.add(var.set_decode_cache_refresh_interval(cache_conf[CONF_REFRESH_INTERVAL]))
+        if CONF_HIT_RATE in cache_conf:
+            sens = await sensor.new_sensor(cache_conf[CONF_HIT_RATE])
+            cg.add(var.set_decode_cache_hit_rate_sensor(sens))
+
+    if CONF_FAULT_HISTORY in config:
+        fault_conf = config[CONF_FAULT_HISTORY]
+        if const.CONF_TIME_ID in fault_conf:
+            clock = await cg.get_variable(fault_conf[const.CONF_TIME_ID])
+            cg.add(var.set_fault_clock(clock))
+        if CONF_LAST_FAULT in fault_conf:
+            txt = await text_sensor.new_text_sensor(fault_conf[CONF_LAST_FAULT])
+            cg.add(var.set_last_fault_sensor(txt))
+        if CONF_FAULT_COUNT in fault_conf:
+            sens = await sensor.new_sensor(fault_conf[CONF_FAULT_COUNT])
+            cg.add(var.set_fault_count_sensor(sens))
+
+    if CONF_LATENCY in config:
+        latency_conf = config[CONF_LATENCY]
+        cg.add_define("USE_AUTOTERM_LATENCY")
+        cg.add(var.set_latency_update_interval(latency_conf[const.CONF_UPDATE_INTERVAL]))
+        for key, (direction, stat) in LATENCY_SENSORS.items():
+            if key in latency_conf:
+                sens = await sensor.new_sensor(latency_conf[key])
+                cg.add(var.set_latency_sensor(direction, stat, sens))
+        if CONF_LOOP_TIME_MAX in latency_conf:
+            sens = await sensor.new_sensor(latency_conf[CONF_LOOP_TIME_MAX])
+            cg.add(var.set_loop_time_max_sensor(sens))
+        if CONF_BYTES_PER_LOOP_MAX in latency_conf:
+            sens = await sensor.new_sensor(latency_conf[CONF_BYTES_PER_LOOP_MAX])
+            cg.add(var.set_bytes_per_loop_max_sensor(sens))
+
+    if CONF_BUS_HEALTH in config:
+        bus_conf = config[CONF_BUS_HEALTH]
+        cg.add(var.set_bus_health_window(bus_conf[CONF_WINDOW]))
+        for direction, direction_key in enumerate(BUS_DIRECTIONS):
+            direction_conf = bus_conf.get(direction_key, {})
+            for counter, key in enumerate(BUS_COUNTERS):
+                if key in direction_conf:
+                    sens = await sensor.new_sensor(direction_conf[key])
+                    cg.add(var.set_bus_total_sensor(direction, counter, sens))
+                if f"{key}_rate" in direction_conf:
+                    sens = await sensor.new_sensor(direction_conf[f"{key}_rate"])
+                    cg.add(var.set_bus_rate_sensor(direction, counter, sens))
+
+    for conf in config.get(CONF_ON_PHASE_CHANGE, []):
+        trigger = cg.new_Pvariable(conf[const.CONF_TRIGGER_ID], var)
+        await automation.build_automation(trigger, [(cg.uint16, "status"), (cg.uint16, "previous")], conf)
+    for conf in config.get(CONF_ON_IGNITION_FAILED, []):
+        trigger = cg.new_Pvariable(conf[const.CONF_TRIGGER_ID], var)
+        await automation.build_automation(trigger, [(cg.uint16, "status")], conf)
+    for conf in config.get(CONF_ON_FRAME, []):
+        trigger = cg.new_Pvariable(conf[const.CONF_TRIGGER_ID], var)
+        cg.add(trigger.set_direction(conf[CONF_DIRECTION]))
+        if CONF_COMMAND in conf:
+            cg.add(trigger.set_command(conf[CONF_COMMAND]))
+        await automation.build_automation(
+            trigger, [(cg.bool_, "from_display"), (cg.uint8, "command"), (FrameRef, "frame")], conf
+        )
+    for conf in config.get(CONF_ON_DISPLAY_CONNECTED, []):
+        trigger = cg.new_Pvariable(conf[const.CONF_TRIGGER_ID], var)
+        await automation.build_automation(trigger, [], conf)
+    for conf in config.get(CONF_ON_DISPLAY_LOST, []):
+        trigger = cg.new_Pvariable(conf[const.CONF_TRIGGER_ID], var)
+        await automation.build_automation(trigger, [], conf)
+    for conf in config.get(CONF_ON_THERMOSTAT_CYCLE, []):
+        trigger = cg.new_Pvariable(conf[const.CONF_TRIGGER_ID], var)
+        await automation.build_automation(trigger, [(cg.bool_, "heating"), (cg.float_, "temperature")], conf)
+    for conf in config.get(CONF_ON_BATTERY_GOVERNOR, []):
+        trigger = cg.new_Pvariable(conf[const.CONF_TRIGGER_ID], var)
+        await automation.build_automation(trigger, [(cg.std_string, "state"), (cg.float_, "voltage")], conf)
+
+
+@automation.register_action(
+    "autoterm_uart.preheat_schedule",
+    PreheatScheduleAction,
+    cv.Schema({
+        cv.GenerateID(): cv.use_id(AutotermUART),
+        cv.Required(CONF_HOUR): cv.templatable(cv.int_range(min=0, max=23)),
+        cv.Required(CONF_MINUTE): cv.templatable(cv.int_range(min=0, max=59)),
+        cv.Optional(CONF_TARGET_TEMPERATURE): cv.templatable(cv.temperature),
+    }),
+)
+async def preheat_schedule_to_code(config, action_id, template_arg, args):
+    cg.add_define("USE_AUTOTERM_PREHEAT")
+    var = cg.new_Pvariable(action_id, template_arg)
+    await cg.register_parented(var, config[const.CONF_ID])
+    hour = await cg.templatable(config[CONF_HOUR], args, cg.uint8)
+    cg.add(var.set_hour(hour))
+    minute = await cg.templatable(config[CONF_MINUTE], args, cg.uint8)
+    cg.add(var.set_minute(minute))
+    if CONF_TARGET_TEMPERATURE in config:
+        target = await cg.templatable(config[CONF_TARGET_TEMPERATURE], args, cg.float_)
+        cg.add(var.set_target_temperature(target))
+    return var
+
+
+@automation.register_action(
+    "autoterm_uart.preheat_cancel",
+    PreheatCancelAction,
+    cv.Schema({
+        cv.GenerateID(): cv.use_id(AutotermUART),
+    }),
+)
+async def preheat_cancel_to_code(config, action_id, template_arg, args):
+    cg.add_define("USE_AUTOTERM_PREHEAT")
+    var = cg.new_Pvariable(action_id, template_arg)
+    await cg.register_parented(var, config[const.CONF_ID])
+    return var
+
+
+@automation.register_action(
+    "autoterm_uart.fault_history_dump",
+    FaultHistoryDumpAction,
+    cv.Schema({
+        cv.GenerateID(): cv.use_id(AutotermUART),
+    }),
+)
+async def fault_history_dump_to_code(config, action_id, template_arg, args):
+    var = cg.new_Pvariable(action_id, template_arg)
+    await cg.register_parented(var, config[const.CONF_ID])
+    return var
+
+
+@automation.register_action(
+    "autoterm_uart.fault_history_clear",
+    FaultHistoryClearAction,
+    cv.Schema({
+        cv.GenerateID(): cv.use_id(AutotermUART),
+    }),
+)
+async def fault_history_clear_to_code(config, action_id, template_arg, args):
+    var = cg.new_Pvariable(action_id, template_arg)
+    await cg.register_parented(var, config[const.CONF_ID])
+    return var
+
+
+@automation.register_action(
+    "autoterm_uart.benchmark",
+    BenchmarkAction,
+    cv.Schema({
+        cv.GenerateID(): cv.use_id(AutotermUART),
+        cv.Optional(CONF_ITERATIONS, default=1000): cv.int_range(min=1, max=20000),
+    }),
+)
+async def benchmark_to_code(config, action_id, template_arg, args):
+    # Messcode nur einkompilieren, wenn die Aktion tatsächlich verwendet wird
+    cg.add_define("USE_AUTOTERM_BENCHMARK")
+    var = cg.new_Pvariable(action_id, template_arg)
+    await cg.register_parented(var, config[const.CONF_ID])
+    cg.add(var.set_iterations(config[CONF_ITERATIONS]))
+    return var
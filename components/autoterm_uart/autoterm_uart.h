@@ -9,14 +9,44 @@
 #include "esphome/core/time.h"
 #include "esphome/core/preferences.h"
 #include "esphome/core/helpers.h"
+#include "esphome/core/automation.h"
+#ifdef USE_TIME
+#include "esphome/components/time/real_time_clock.h"
+#endif
+#ifdef USE_ESP32
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
+#ifdef USE_AUTOTERM_TELEMETRY
+#include "esphome/components/network/util.h"
+#include "esphome/components/socket/socket.h"
+#endif
+#ifdef USE_AUTOTERM_METRICS
+#include "esphome/components/web_server_base/web_server_base.h"
+#ifdef USE_ESP32
+#include <esp_heap_caps.h>
+#endif
+#endif
+#ifdef USE_HOST
+#include <chrono>
+#include <thread>
+#endif
 #include <algorithm>
+#include <atomic>
 #include <cctype>
+#include <cstring>
 #include <cmath>
+#include <cstdarg>
 #include <set>
 #include <string>
 #include <vector>
 
 namespace esphome {
+#ifndef USE_TIME
+namespace time {
+class RealTimeClock;
+}  // namespace time
+#endif
 namespace autoterm_uart {
 
 using namespace esphome::uart;
@@ -24,6 +54,202 @@ using namespace esphome::sensor;
 
 class AutotermUART;      // Vorwärtsdeklaration
 class AutotermClimate;   // Vorwärtsdeklaration
+#ifdef USE_AUTOTERM_METRICS
+class AutotermMetricsHandler;
+#endif
+
+// ===================
+// Lock-freier Single-Producer/Single-Consumer-Ring (RX-Task ↔ loop())
+// ===================
+template<typename T, size_t N> class SpscRing {
+  static_assert((N & (N - 1)) == 0, "SpscRing size must be a power of two");
+
+ public:
+  // Producer: freien Slot holen, befüllen, dann commit_write()
+  T *acquire_write() {
+    uint32_t head = head_.load(std::memory_order_relaxed);
+    if (head - tail_.load(std::memory_order_acquire) >= N)
+      return nullptr;
+    return &slots_[head & (N - 1)];
+  }
+  void commit_write() { head_.store(head_.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+  // Consumer: ältesten Slot lesen, dann commit_read()
+  const T *peek_read() const {
+    uint32_t tail = tail_.load(std::memory_order_relaxed);
+    if (head_.load(std::memory_order_acquire) == tail)
+      return nullptr;
+    return &slots_[tail & (N - 1)];
+  }
+  void commit_read() { tail_.store(tail_.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+ protected:
+  T slots_[N];
+  std::atomic<uint32_t> head_{0};
+  std::atomic<uint32_t> tail_{0};
+};
+
+#ifdef USE_AUTOTERM_LATENCY
+// Histogramm mit festen Buckets (µs) für die Weiterleitungslatenz
+struct LatencyHistogram {
+  static constexpr uint8_t BUCKETS = 12;
+  static constexpr uint32_t BUCKET_LIMITS_US[BUCKETS] = {250,   500,   1000,   2000,   4000,   8000,
+                                                         16000, 32000, 64000, 128000, 256000, UINT32_MAX};
+  uint32_t counts[BUCKETS]{};
+  uint32_t total{0};
+  uint32_t max_us{0};
+  uint64_t sum_us{0};
+
+  void record(uint32_t us) {
+    uint8_t i = 0;
+    while (us > BUCKET_LIMITS_US[i])
+      i++;
+    counts[i]++;
+    total++;
+    sum_us += us;
+    if (us > max_us)
+      max_us = us;
+  }
+  // Obergrenze des Buckets, in dem das Perzentil liegt (höchstens max_us)
+  uint32_t percentile_us(uint8_t percent) const {
+    if (total == 0)
+      return 0;
+    uint32_t target = (static_cast<uint64_t>(total) * percent + 99) / 100;
+    uint32_t cumulative = 0;
+    for (uint8_t i = 0; i < BUCKETS; i++) {
+      cumulative += counts[i];
+      if (cumulative >= target)
+        return std::min(BUCKET_LIMITS_US[i], max_us);
+    }
+    return max_us;
+  }
+  void reset() { *this = LatencyHistogram{}; }
+};
+#endif
+
+struct QueuedFrame {
+  static constexpr size_t MAX_LENGTH = 64;
+  uint8_t length;
+  bool from_display;
+  uint8_t data[MAX_LENGTH];
+};
+
+// ===================
+// Betriebsarten (Climate-Presets) und Beschriftungen
+// ===================
+enum class HeaterMode : uint8_t { NONE = 0, POWER, HEAT, HEAT_FAN, THERMOSTAT };
+enum class LabelLanguage : uint8_t { DE = 0, EN };
+
+static constexpr uint8_t HEATER_MODE_COUNT = 5;
+static constexpr uint8_t LABEL_LANGUAGE_COUNT = 2;
+static constexpr const char *HEATER_MODE_LABELS[LABEL_LANGUAGE_COUNT][HEATER_MODE_COUNT] = {
+    {"", "Leistungsmodus", "Heizen", "Heizen+Lüften", "Thermostat"},
+    {"", "Power", "Heat", "Heat+Fan", "Thermostat"},
+};
+static constexpr const char *FAN_LEVEL_LABELS[LABEL_LANGUAGE_COUNT][10] = {
+    {"Stufe 0", "Stufe 1", "Stufe 2", "Stufe 3", "Stufe 4", "Stufe 5", "Stufe 6", "Stufe 7", "Stufe 8", "Stufe 9"},
+    {"Level 0", "Level 1", "Level 2", "Level 3", "Level 4", "Level 5", "Level 6", "Level 7", "Level 8", "Level 9"},
+};
+
+constexpr const char *heater_mode_label(HeaterMode mode, LabelLanguage language = LabelLanguage::DE) {
+  return HEATER_MODE_LABELS[static_cast<uint8_t>(language)][static_cast<uint8_t>(mode)];
+}
+constexpr const char *fan_level_label(uint8_t level, LabelLanguage language = LabelLanguage::DE) {
+  return FAN_LEVEL_LABELS[static_cast<uint8_t>(language)][level > 9 ? 9 : level];
+}
+
+// ===================
+// Festkomma-Einheiten: Temperaturen in 0,1 °C, Spannung in 0,1 V, Pumpe in 0,01 Hz
+// ===================
+static constexpr int16_t TEMP_DC_INVALID = INT16_MIN;
+
+struct StatusFrame {
+  uint16_t status_code;
+  uint8_t status_major;  // Statusanzeige "x.y" = major + minor/10
+  uint8_t status_minor;
+  int16_t internal_temp_dc;
+  int16_t external_temp_dc;
+  int16_t heater_temp_dc;  // TEMP_DC_INVALID bei 0xFFFF oder außerhalb des int16-Bereichs
+  uint8_t voltage_dv;
+  uint16_t fan_set_rpm;
+  uint16_t fan_actual_rpm;
+  uint8_t pump_chz;
+  uint8_t error_code;  // 0 = kein Fehler, sonst "Exx" wie am Bedienteil
+};
+
+// ===================
+// Fehlercodes der Heizung (dezimal wie in der Bedienungsanleitung), nach Code sortiert
+// ===================
+struct FaultCodeInfo {
+  uint8_t code;
+  const char *text;
+};
+static constexpr FaultCodeInfo FAULT_CODES[] = {
+    {1, "Überhitzung Wärmetauscher"},
+    {2, "Mögliche Überhitzung (Temperaturdifferenz)"},
+    {4, "Temperaturfühler Steuergerät defekt"},
+    {5, "Flammensensor defekt"},
+    {6, "Temperaturfühler Wärmetauscher defekt"},
+    {8, "Flamme im Betrieb erloschen"},
+    {9, "Glühkerze defekt"},
+    {10, "Gebläse erreicht Drehzahl nicht"},
+    {12, "Abschaltung: Überspannung"},
+    {13, "Zündung fehlgeschlagen"},
+    {15, "Abschaltung: Unterspannung"},
+    {16, "Flammensensor kühlt nicht ab"},
+    {17, "Dosierpumpe defekt"},
+    {20, "Keine Verbindung zum Bedienteil"},
+    {27, "Gebläsemotor dreht nicht"},
+    {28, "Gebläsemotor dreht unkontrolliert"},
+    {29, "Flammenabriss im Betrieb"},
+    {33, "Heizung gesperrt (wiederholte Überhitzung)"},
+    {78, "Flammenabriss"},
+};
+static constexpr size_t FAULT_CODE_COUNT = sizeof(FAULT_CODES) / sizeof(FAULT_CODES[0]);
+constexpr bool fault_codes_sorted(size_t i = 1) {
+  return i >= FAULT_CODE_COUNT || (FAULT_CODES[i - 1].code < FAULT_CODES[i].code && fault_codes_sorted(i + 1));
+}
+static_assert(fault_codes_sorted(), "FAULT_CODES muss nach Code sortiert sein");
+
+inline const char *fault_code_text(uint8_t code) {
+  const FaultCodeInfo *end = FAULT_CODES + FAULT_CODE_COUNT;
+  const FaultCodeInfo *it = std::lower_bound(FAULT_CODES, end, code,
+                                             [](const FaultCodeInfo &info, uint8_t c) { return info.code < c; });
+  return (it != end && it->code == code) ? it->text : "Unbekannter Fehler";
+}
+
+#ifdef USE_AUTOTERM_BATTERY_GOVERNOR
+// ===================
+// Batterie-Wächter: Eskalationsstufen nach gefilterter Spannung und Trend
+// ===================
+enum class BatteryGovernorState : uint8_t { NORMAL = 0, REDUCED, IGNITION_BLOCKED, SHUTDOWN };
+
+inline const char *battery_governor_state_text(BatteryGovernorState state) {
+  switch (state) {
+    case BatteryGovernorState::REDUCED:
+      return "Leistung reduziert";
+    case BatteryGovernorState::IGNITION_BLOCKED:
+      return "Zündsperre";
+    case BatteryGovernorState::SHUTDOWN:
+      return "Abgeschaltet";
+    default:
+      return "Normal";
+  }
+}
+#endif
+
+// Umrechnung nach float erst an der Publish-Grenze
+inline float deci_to_float(int16_t value_dc) { return value_dc == TEMP_DC_INVALID ? NAN : value_dc / 10.0f; }
+inline int16_t float_to_deci(float value) {
+  if (!std::isfinite(value))
+    return TEMP_DC_INVALID;
+  float scaled = value * 10.0f;
+  if (scaled > 32767.0f)
+    return 32767;
+  if (scaled < -32767.0f)
+    return -32767;
+  return static_cast<int16_t>(std::lround(scaled));
+}
 
 // ===================
 // Custom Number Class
@@ -37,6 +263,7 @@ class AutotermFanLevelNumber : public number::Number {
   void control(float value) override;  // Implementierung folgt unten
 };
 
+#ifdef USE_AUTOTERM_TEMP_SOURCE_SELECT
 class AutotermTempSourceSelect : public select::Select {
  public:
   void set_parent(AutotermUART *parent);
@@ -50,6 +277,7 @@ class AutotermTempSourceSelect : public select::Select {
   const char *option_from_source_(uint8_t source) const;
   uint8_t source_from_option_(const std::string &option) const;
 };
+#endif
 
 // ===================
 // Hauptklasse UART
@@ -71,18 +299,34 @@ class AutotermUART : public Component {
   Sensor *fan_speed_set_sensor_{nullptr};
   Sensor *fan_speed_actual_sensor_{nullptr};
   Sensor *pump_frequency_sensor_{nullptr};
+#ifdef USE_AUTOTERM_STATUS_TEXT
   text_sensor::TextSensor *status_text_sensor_{nullptr};
+  uint16_t status_text_published_code_{0xFFFF};
+#endif
+  int16_t panel_temp_override_dc_{TEMP_DC_INVALID};
+#ifdef USE_AUTOTERM_PANEL_OVERRIDE
   Sensor *panel_temp_override_sensor_{nullptr};
   float panel_temp_override_value_c_{NAN};
+  // Autonomer Modus: senden bei Änderung ≥ min_delta, sonst nur Keepalive (Panel-Takt ~6 s)
+  uint8_t panel_temp_override_byte_{0};
+  float panel_temp_override_min_delta_c_{0.5f};
+  uint32_t panel_temp_override_keepalive_ms_{6000};
+  float panel_temp_override_sent_c_{NAN};
+  bool panel_temp_override_pending_{false};
+  uint32_t last_panel_temp_send_millis_{0};
+#endif
+#ifdef USE_AUTOTERM_TEMP_SOURCE_SELECT
   AutotermTempSourceSelect *temp_source_select_{nullptr};
+#endif
   bool manual_temp_source_active_{false};
   uint8_t manual_temp_source_value_{0};
-  float last_internal_temp_c_{NAN};
-  float last_external_temp_c_{NAN};
+  int16_t last_internal_temp_dc_{TEMP_DC_INVALID};
+  int16_t last_external_temp_dc_{TEMP_DC_INVALID};
 
 
   AutotermFanLevelNumber *fan_level_number_{nullptr};
   AutotermClimate *climate_{nullptr};
+#ifdef USE_AUTOTERM_RUNTIME
   Sensor *runtime_hours_sensor_{nullptr};
   Sensor *session_runtime_sensor_{nullptr};
   ESPPreferenceObject runtime_hours_pref_;
@@ -94,9 +338,10 @@ class AutotermUART : public Component {
   bool runtime_dirty_{false};
   bool runtime_tracking_initialized_{false};
   bool runtime_storage_initialized_{false};
-  bool heater_running_{false};
   uint32_t last_runtime_millis_{0};
   uint32_t last_runtime_save_millis_{0};
+#endif
+  bool heater_running_{false};
 
   struct Settings {
     uint8_t use_work_time = 1;
@@ -107,28 +352,531 @@ class AutotermUART : public Component {
     uint8_t power_level = 8;
   } settings_;
   bool settings_valid_{false};
+
+#ifdef USE_AUTOTERM_HEATER_MODEL
+  // Modell-/Firmwareerkennung: Abfrage 0x06 ohne Bedienteil bzw. dessen Abfrage mitgelesen, danach nicht mehr geprüft
+  static constexpr uint8_t MODEL_QUERY_ATTEMPTS = 3;
+  text_sensor::TextSensor *heater_model_sensor_{nullptr};
+  bool model_query_done_{false};
+  uint8_t model_query_attempts_{0};
+  uint32_t model_query_millis_{0};
+  uint8_t heater_model_id_{0xFF};
+  char firmware_version_[16]{};
+#endif
+
+#ifdef USE_AUTOTERM_FAULT_HISTORY
+  // Fehlerhistorie: Ringpuffer im Flash, ein Eintrag pro neu auftretendem Fehlercode
+  static constexpr uint8_t FAULT_HISTORY_SIZE = 8;
+  struct FaultRecord {
+    uint32_t timestamp;   // Unix-Zeit, 0 ohne gültige Uhr
+    uint32_t uptime_s;
+    float runtime_hours;  // NAN ohne Betriebsstundenzähler
+    int16_t heater_temp_dc;
+    uint16_t status_code;
+    uint8_t code;
+    uint8_t voltage_dv;
+  };
+  struct FaultHistory {
+    FaultRecord records[FAULT_HISTORY_SIZE];
+    uint32_t total;
+    uint8_t head;  // nächster Schreibplatz
+    uint8_t count;
+  } fault_history_{};
+  ESPPreferenceObject fault_history_pref_;
+  bool fault_history_storage_{false};
+  uint8_t active_fault_code_{0};
+  time::RealTimeClock *fault_clock_{nullptr};
+  text_sensor::TextSensor *last_fault_sensor_{nullptr};
+  Sensor *fault_count_sensor_{nullptr};
+#endif
+
+  // Konsistente Sicht auf einen Status-/Settings-Frame für Lambdas und andere Komponenten
+  struct HeaterSnapshot {
+    uint32_t seq{0};
+    uint32_t timestamp_ms{0};
+    bool status_valid{false};
+    uint16_t status_code{0};
+    uint8_t fault_code{0};
+    char status_text[32]{"Unbekannt"};  // Kopie, damit ein Snapshot nicht auf Puffer von parse_status zeigt
+    float internal_temp_c{NAN};
+    float external_temp_c{NAN};
+    float heater_temp_c{NAN};
+    float panel_temp_c{NAN};
+    float voltage_v{NAN};
+    float fan_speed_set_rpm{NAN};
+    float fan_speed_actual_rpm{NAN};
+    float pump_frequency_hz{NAN};
+    bool heater_running{false};
+    bool display_connected{false};
+    bool settings_valid{false};
+    Settings settings{};
+  } snapshot_;
   bool display_connected_state_{false};
-  uint32_t last_display_activity_{0};
+  std::atomic<uint32_t> last_display_activity_{0};
   uint32_t last_status_request_millis_{0};
   uint32_t last_settings_request_millis_{0};
-  uint32_t last_panel_temp_send_millis_{0};
-  float panel_temp_last_value_c_{NAN};
+#ifdef USE_AUTOTERM_PANEL_EMULATION
+  // Virtuelles Panel: gleicher Zyklus wie das Original, ein Frame pro Slot, Phase vom Display übernommen
+  static constexpr uint8_t PANEL_CYCLE_LENGTH = 3;
+  static constexpr uint8_t PANEL_CYCLE[PANEL_CYCLE_LENGTH] = {0x11, 0x02, 0x0F};
+  uint32_t panel_slot_ms_{2000};
+  uint32_t panel_next_slot_millis_{0};
+  uint8_t panel_cycle_index_{0};
+  bool panel_emulation_active_{false};
+  uint32_t panel_takeovers_{0};
+  uint32_t panel_last_switchover_ms_{0};
+  Sensor *panel_switchover_sensor_{nullptr};
+  Sensor *panel_takeover_sensor_{nullptr};
+#endif
+  int16_t panel_temp_last_dc_{TEMP_DC_INVALID};
+  // RX-Task: besitzt beide UARTs, loop() bekommt geparste Frames über rx_queue_
+  bool rx_task_enabled_{false};
+  bool rx_task_running_{false};
+  uint8_t rx_task_priority_{18};
+  std::atomic<bool> rx_task_stop_{false};
+#ifdef USE_HOST
+  std::thread rx_thread_;
+#endif
+  // Eingaben der Frame-Umschreibung: loop() packt sie in ein Wort, forward_frame_ liest nur diese Kopie.
+  // Byte 0 Panel-Temperatur, Byte 1 erzwungene Fühlerkennung, Byte 2 Stufengrenze, Byte 3 RewriteFlag
+  static constexpr uint8_t REWRITE_NONE = 0xFF;
+  enum RewriteFlag : uint8_t { REWRITE_BLOCK_START = 1 << 0 };
+  std::atomic<uint32_t> rewrite_inputs_{0x0009FFFFu};
+  SpscRing<QueuedFrame, 16> rx_queue_;
+  SpscRing<QueuedFrame, 8> tx_queue_;
+  std::atomic<uint32_t> rx_queue_dropped_{0};
+  uint32_t rx_queue_dropped_reported_{0};
+  uint32_t tx_queue_dropped_{0};
+  std::vector<uint8_t> rx_task_frame_scratch_;
+
+  // Bus-Zustand pro Richtung (0 = display→heater, 1 = heater→display)
+  enum BusCounter : uint8_t {
+    BUS_FRAMES_OK = 0,
+    BUS_CRC_ERRORS,
+    BUS_RESYNCS,
+    BUS_ABORTED_FRAMES,
+    BUS_STRAY_BYTES,
+    BUS_INJECTED_FRAMES,
+    BUS_REWRITTEN_FRAMES,
+    BUS_COUNTER_COUNT,
+  };
+  // Gespeicherte Form; zur Laufzeit zählen RX-Task und loop() in bus_counters_ (je Feld atomar)
+  struct BusCounters {
+    uint32_t values[2][BUS_COUNTER_COUNT];
+  };
+  std::atomic<uint32_t> bus_counters_[2][BUS_COUNTER_COUNT]{};
+  static constexpr uint8_t MAX_PAYLOAD = 48;
+  // Erwartete Payload-Längen je (Gerätekennung, Funktionscode); ein Kommando darf mehrere Einträge haben
+  struct FrameLengthRule {
+    uint8_t device;
+    uint8_t command;
+    uint8_t length;
+  };
+  static constexpr uint8_t MAX_FRAME_LENGTH_RULES = 32;
+  FrameLengthRule frame_length_rules_[MAX_FRAME_LENGTH_RULES]{
+      {0x03, 0x01, 6},  {0x03, 0x02, 0}, {0x03, 0x02, 6}, {0x03, 0x03, 0}, {0x03, 0x0F, 0},
+      {0x03, 0x11, 1},  {0x03, 0x23, 4}, {0x04, 0x01, 6}, {0x04, 0x02, 6}, {0x04, 0x03, 0},
+      {0x04, 0x0F, 0x13}, {0x04, 0x11, 1}, {0x04, 0x23, 4},
+  };
+  uint8_t frame_length_rule_count_{13};
+
+#ifdef USE_AUTOTERM_DECODE_CACHE
+  // Dekodier-Cache: bitgleiche Status-/Settings-Frames (gleiche CRC, gleiche Bytes) werden nicht erneut ausgewertet
+  enum DecodeCacheSlot : uint8_t { DECODE_CACHE_STATUS = 0, DECODE_CACHE_SETTINGS, DECODE_CACHE_SLOTS };
+  struct DecodeCacheEntry {
+    uint16_t crc;
+    uint8_t length;  // 0 = leer
+    uint8_t frame[5 + MAX_PAYLOAD + 2];
+    uint32_t decoded_millis;
+  };
+  DecodeCacheEntry decode_cache_[DECODE_CACHE_SLOTS]{};
+  uint32_t decode_cache_refresh_ms_{30000};
+  uint32_t decode_cache_hits_[DECODE_CACHE_SLOTS]{};
+  uint32_t decode_cache_misses_[DECODE_CACHE_SLOTS]{};
+  Sensor *decode_cache_hit_rate_sensor_{nullptr};
+  uint32_t decode_cache_last_publish_millis_{0};
+#endif
+
+  // Befehlsabsichten: schnelle Folgen je Klasse (Slider, Zieltemperatur) zusammenfassen, nur der letzte Wert geht raus
+  enum CommandClass : uint8_t { COMMAND_CLASS_MODE = 0, COMMAND_CLASS_SETTINGS, COMMAND_CLASS_COUNT };
+#ifdef USE_AUTOTERM_COMMAND_WINDOW
+  static constexpr uint8_t INTENT_MAX_PAYLOAD = 8;
+  struct CommandIntent {
+    bool pending;
+    uint8_t command;
+    uint8_t length;
+    uint8_t payload[INTENT_MAX_PAYLOAD];
+    const char *label;
+    uint32_t first_millis;
+    uint32_t last_millis;
+  };
+  CommandIntent command_intents_[COMMAND_CLASS_COUNT]{};
+  uint8_t command_intents_pending_{0};
+  uint32_t command_window_ms_{250};
+  uint32_t commands_coalesced_{0};
+  uint32_t commands_coalesced_published_{0};
+  Sensor *commands_coalesced_sensor_{nullptr};
+#endif
+
+  // Sollzustand: zuletzt angeforderter Betrieb, wird gegen jeden Status-/Settings-Frame abgeglichen
+  enum class DesiredRun : uint8_t { OFF = 0, FAN, POWER, HEAT, HEAT_FAN };
+#ifdef USE_AUTOTERM_RECONCILE
+  struct DesiredState {
+    bool active;
+    DesiredRun run;
+    uint8_t level;
+    uint8_t sensor;  // Sensorbyte wie an die Heizung gesendet
+    uint8_t set_temp;
+  } desired_{};
+  bool reconcile_resend_{false};
+  bool reconcile_gave_up_{false};
+  // Von handle_phase_change_ erkannte Fehlzündung: kein automatischer Neustart, bis ein neuer Befehl kommt
+  bool ignition_failed_latched_{false};
+  uint8_t reconcile_attempts_{0};
+  uint8_t reconcile_max_retries_{3};
+  uint32_t reconcile_settle_ms_{10000};
+  uint32_t reconcile_last_action_millis_{0};
+  uint32_t reconcile_corrections_{0};
+  uint32_t commands_skipped_{0};
+#endif
+#ifdef USE_AUTOTERM_TELEMETRY
+  // Telemetrie: ein Datensatz fester Länge (little endian) pro Status-/Settings-Frame, N Datensätze pro UDP-Datagramm
+  static constexpr uint8_t TELEMETRY_VERSION = 1;
+  static constexpr size_t TELEMETRY_HEADER_SIZE = 8;
+  static constexpr size_t TELEMETRY_RECORD_SIZE = 36;
+  static constexpr uint8_t TELEMETRY_MAX_BATCH = 32;
+  std::string telemetry_host_;
+  uint16_t telemetry_port_{0};
+  uint8_t telemetry_batch_size_{8};
+  uint32_t telemetry_flush_ms_{5000};
+  std::unique_ptr<socket::Socket> telemetry_socket_;
+  struct sockaddr_storage telemetry_addr_ {};
+  socklen_t telemetry_addr_len_{0};
+  uint8_t telemetry_buffer_[TELEMETRY_HEADER_SIZE + TELEMETRY_MAX_BATCH * TELEMETRY_RECORD_SIZE]{};
+  uint8_t telemetry_count_{0};
+  uint32_t telemetry_first_millis_{0};
+  uint32_t telemetry_seq_{0};
+  uint32_t telemetry_sent_{0};
+  uint32_t telemetry_dropped_{0};
+  uint32_t telemetry_dropped_published_{0};
+  uint32_t telemetry_last_error_log_millis_{0};
+  StatusFrame telemetry_status_{};
+  Sensor *telemetry_dropped_sensor_{nullptr};
+#endif
+  uint8_t unknown_command_max_length_{32};
+  uint32_t last_byte_millis_[2]{0, 0};
+  bool in_resync_[2]{false, false};
+  uint32_t resync_bytes_[2]{0, 0};
+  uint16_t resync_frames_[2]{0, 0};
+  uint32_t last_resync_bytes_[2]{0, 0};
+  uint16_t last_resync_frames_[2]{0, 0};
+  std::atomic<uint32_t> resync_reports_[2]{};
+  uint32_t resync_reported_[2]{0, 0};
+#ifdef USE_AUTOTERM_BUS_HEALTH
+  static constexpr uint8_t BUS_RATE_SLOTS = 6;
+  uint32_t bus_history_[BUS_RATE_SLOTS][2][BUS_COUNTER_COUNT]{};
+  uint8_t bus_history_index_{0};
+  uint8_t bus_history_filled_{0};
+  Sensor *bus_total_sensors_[2][BUS_COUNTER_COUNT]{};
+  Sensor *bus_rate_sensors_[2][BUS_COUNTER_COUNT]{};
+  uint32_t bus_window_ms_{60000};
+  uint32_t bus_last_slot_millis_{0};
+  uint32_t bus_last_save_millis_{0};
+  ESPPreferenceObject bus_counters_pref_;
+#endif
+#ifdef USE_AUTOTERM_LATENCY
+  // Index 0 = display→heater, 1 = heater→display
+  enum LatencyStat : uint8_t { LATENCY_P50 = 0, LATENCY_P99, LATENCY_MAX };
+  LatencyHistogram latency_[2];
+  uint32_t frame_start_us_[2]{0, 0};
+  // Übergabe an loop(): der Besitzer der UARTs kopiert Histogramme und Bytezähler auf Anforderung und setzt sie zurück
+  struct LatencySnapshot {
+    LatencyHistogram latency[2];
+    uint32_t bytes_total;
+    uint32_t bytes_per_pass_max;
+  } latency_snapshot_{};
+  std::atomic<bool> latency_snapshot_requested_{false};
+  std::atomic<bool> latency_snapshot_ready_{false};
+  Sensor *latency_sensors_[2][3]{};
+  Sensor *loop_time_max_sensor_{nullptr};
+  Sensor *bytes_per_loop_max_sensor_{nullptr};
+  uint32_t latency_update_interval_ms_{60000};
+  uint32_t latency_last_publish_millis_{0};
+  uint32_t loop_time_max_us_{0};
+  uint32_t loop_time_sum_us_{0};
+  uint32_t loop_count_{0};
+  uint32_t bytes_this_loop_{0};
+  uint32_t bytes_per_loop_max_{0};
+  uint32_t bytes_total_{0};
+#endif
+#ifdef USE_AUTOTERM_METRICS
+  // /metrics: loop() rendert alle update_interval in den hinteren Puffer und schaltet um; der Webserver
+  // liefert den vorderen ohne Kopie aus. Latenz und Loop-Zeit kumulativ statt pro Fenster
+  static constexpr size_t METRICS_BUFFER_SIZE = 6144;
+  char metrics_buffers_[2][METRICS_BUFFER_SIZE];
+  size_t metrics_lengths_[2]{0, 0};
+  std::atomic<int8_t> metrics_front_{-1};  // -1 = noch nichts gerendert
+  char *metrics_target_{nullptr};
+  size_t metrics_length_{0};
+  bool metrics_overflow_{false};
+  uint32_t metrics_interval_ms_{10000};
+  uint32_t metrics_last_render_millis_{0};
+#ifdef USE_AUTOTERM_LATENCY
+  // Von loop() pro Latenzfenster aus dem Snapshot aufsummiert
+  LatencyHistogram latency_total_[2];
+  uint64_t loop_time_total_us_{0};
+  uint32_t loop_iterations_total_{0};
+#endif
+#endif
+  // Puffer werden in setup() einmal reserviert; erase()/assign() geben die Kapazität nicht frei.
+  // Allokationsfrei ist damit Framing, Weiterleitung und Dekodierung, nicht das Veröffentlichen:
+  // Climate- und Textsensor-Publishes allokieren in ESPHome (prüfbar mit autoterm_uart.benchmark)
   std::vector<uint8_t> display_to_heater_buffer_;
+  std::vector<uint8_t> frame_scratch_[2];
   std::vector<uint8_t> heater_to_display_buffer_;
+#ifdef USE_AUTOTERM_BENCHMARK
+  // Läuft in Häppchen aus loop(). FRAMING bricht nach der CRC-Prüfung ab, REPLAY dekodiert zusätzlich,
+  // aber ohne Weiterleitung, Umschreibung, Log und Publish
+  enum BenchmarkStage : uint8_t { BENCH_OFF = 0, BENCH_CRC, BENCH_DECODE, BENCH_FRAMING, BENCH_REPLAY, BENCH_DONE };
+  static constexpr uint32_t BENCH_CHUNK_BUDGET_US = 2000;
+  BenchmarkStage benchmark_stage_{BENCH_OFF};
+  uint32_t benchmark_iterations_{0};
+  uint32_t benchmark_stage_done_{0};
+  uint32_t benchmark_stage_us_[BENCH_DONE - BENCH_CRC]{};
+  uint32_t benchmark_sink_{0};
+  std::vector<uint8_t> benchmark_buffer_;
+  std::vector<uint8_t> benchmark_status_frame_;
+  // parse_* und Thermostat haben Seiteneffekte und werden daher im echten Betrieb gemessen,
+  // jeweils seit dem letzten Bericht; parse_status enthält die Thermostat-Auswertung
+  enum ProfiledCall : uint8_t { PROFILE_PARSE_STATUS = 0, PROFILE_PARSE_SETTINGS, PROFILE_THERMOSTAT, PROFILE_COUNT };
+  struct CallProfile {
+    uint32_t calls;
+    uint32_t total_us;
+    uint32_t max_us;
+  };
+  CallProfile call_profile_[PROFILE_COUNT]{};
+  class ProfileScope {
+   public:
+    explicit ProfileScope(CallProfile &profile) : profile_(profile), start_us_(micros()) {}
+    ~ProfileScope() {
+      uint32_t us = micros() - start_us_;
+      profile_.calls++;
+      profile_.total_us += us;
+      profile_.max_us = std::max(profile_.max_us, us);
+    }
+
+   protected:
+    CallProfile &profile_;
+    uint32_t start_us_;
+  };
+  void run_benchmark_chunk_();
+  void run_benchmark_batch_(uint32_t count);
+  void replay_benchmark_frame_(const std::vector<uint8_t> &frame, bool from_display);
+  void report_benchmark_();
+#endif
   bool thermostat_active_{false};
+#ifdef USE_AUTOTERM_THERMOSTAT
   bool thermostat_heating_request_{false};
   bool thermostat_waiting_for_idle_{false};
-  float thermostat_target_c_{20.0f};
-  float thermostat_hys_on_c_{2.0f};
-  float thermostat_hys_off_c_{1.0f};
+  int16_t thermostat_target_dc_{200};
+  int16_t thermostat_hys_on_dc_{20};
+  int16_t thermostat_hys_off_dc_{10};
   uint8_t thermostat_level_{4};
   uint8_t thermostat_sensor_source_{1};
   uint8_t thermostat_last_sent_level_{255};
   uint32_t thermostat_last_command_millis_{0};
   uint32_t thermostat_last_evaluation_millis_{0};
+#endif
+
+#ifdef USE_AUTOTERM_PREHEAT
+  // Vorheizen bis Uhrzeit (Aufheizrate gelernt je Stufe und Außentemperatur, nur mit preheat)
+  static constexpr uint8_t WARMUP_LEVELS = 10;
+  static constexpr uint8_t WARMUP_OUTSIDE_BINS = 4;
+  struct WarmupModel {
+    float rate_c_per_min[WARMUP_LEVELS][WARMUP_OUTSIDE_BINS];
+    uint8_t samples[WARMUP_LEVELS][WARMUP_OUTSIDE_BINS];
+  } warmup_model_{};
+  ESPPreferenceObject warmup_model_pref_;
+  bool warmup_model_dirty_{false};
+  bool warmup_sample_active_{false};
+  float warmup_sample_start_c_{NAN};
+  uint32_t warmup_sample_start_millis_{0};
+  uint8_t warmup_sample_level_{0};
+  uint8_t warmup_sample_bin_{0};
+
+  time::RealTimeClock *preheat_clock_{nullptr};
+  text_sensor::TextSensor *preheat_status_sensor_{nullptr};
+  uint8_t preheat_level_{8};
+  float preheat_default_target_c_{20.0f};
+  float preheat_default_rate_c_per_min_{0.3f};
+  uint32_t preheat_startup_s_{300};
+  uint32_t preheat_max_lead_s_{3 * 3600};
+  bool preheat_scheduled_{false};
+  uint8_t preheat_hour_{0};
+  uint8_t preheat_minute_{0};
+  float preheat_target_c_{20.0f};
+  int64_t preheat_deadline_ts_{0};
+  uint32_t preheat_last_evaluation_millis_{0};
+  int32_t preheat_published_start_min_{-1};
+#endif
+
+  // Automation-Callbacks, je Trigger nur einkompiliert, wenn er konfiguriert ist
+#ifdef USE_AUTOTERM_ON_PHASE_CHANGE
+  CallbackManager<void(uint16_t, uint16_t)> phase_change_callback_;
+#endif
+#ifdef USE_AUTOTERM_ON_IGNITION_FAILED
+  CallbackManager<void(uint16_t)> ignition_failed_callback_;
+#endif
+#ifdef USE_AUTOTERM_ON_FRAME
+  CallbackManager<void(bool, uint8_t, const std::vector<uint8_t> &)> frame_callback_;
+#endif
+#ifdef USE_AUTOTERM_ON_DISPLAY_CONNECTED
+  CallbackManager<void()> display_connected_callback_;
+#endif
+#ifdef USE_AUTOTERM_ON_DISPLAY_LOST
+  CallbackManager<void()> display_lost_callback_;
+#endif
+#ifdef USE_AUTOTERM_ON_THERMOSTAT_CYCLE
+  CallbackManager<void(bool, float)> thermostat_cycle_callback_;
+#endif
+  uint16_t last_status_code_{0xFFFF};
+  uint32_t last_standby_millis_{0};
+  uint32_t ignitions_{0};
+  uint32_t ignition_failures_{0};
+#ifdef USE_AUTOTERM_BATTERY_GOVERNOR
+  // Batterie-Wächter: Entscheidung auf der Prognose (gefiltert + fallender Trend × lookahead), Freigabe erst über resume
+  float battery_reduce_below_v_{12.2f};
+  float battery_block_below_v_{12.0f};
+  float battery_stop_below_v_{11.6f};
+  float battery_resume_above_v_{12.8f};
+  uint32_t battery_filter_ms_{60000};
+  uint32_t battery_trend_ms_{900000};  // länger als filter_time: die Heizung meldet nur 0,1-V-Schritte
+  uint32_t battery_lookahead_ms_{600000};
+  uint32_t battery_step_interval_ms_{120000};
+  uint8_t battery_min_level_{0};
+  BatteryGovernorState battery_state_{BatteryGovernorState::NORMAL};
+  uint8_t battery_level_cap_{9};  // 9 = keine Begrenzung
+  float battery_filtered_v_{NAN};
+  float battery_trend_vph_{0.0f};
+  float battery_filtered_published_{NAN};
+  float battery_trend_published_{NAN};
+  uint32_t battery_last_sample_millis_{0};
+  uint32_t battery_last_step_millis_{0};
+  uint32_t battery_last_enforce_millis_{0};
+  bool battery_block_logged_{false};
+  bool battery_publish_pending_{false};
+  uint32_t battery_blocked_starts_{0};
+  // Vom Weiterleitungspfad verworfene Panel-Starts; loop() übernimmt die Differenz
+  std::atomic<uint32_t> battery_panel_blocked_{0};
+  uint32_t battery_panel_blocked_seen_{0};
+  text_sensor::TextSensor *battery_state_sensor_{nullptr};
+  Sensor *battery_filtered_sensor_{nullptr};
+  Sensor *battery_trend_sensor_{nullptr};
+  CallbackManager<void(std::string, float)> battery_governor_callback_;
+#endif
 
   void set_uart_display(UARTComponent *u) { uart_display_ = u; }
   void set_uart_heater(UARTComponent *u) { uart_heater_ = u; }
+  void set_rx_task(bool enabled) { rx_task_enabled_ = enabled; }
+  void set_rx_task_priority(uint8_t priority) { rx_task_priority_ = priority; }
+  void add_frame_length(uint8_t device, uint8_t command, uint8_t length) {
+    if (frame_length_rule_count_ >= MAX_FRAME_LENGTH_RULES)
+      return;
+    frame_length_rules_[frame_length_rule_count_++] = {device, command, std::min(length, MAX_PAYLOAD)};
+  }
+  void set_unknown_command_max_length(uint8_t length) { unknown_command_max_length_ = std::min(length, MAX_PAYLOAD); }
+#ifdef USE_AUTOTERM_BUS_HEALTH
+  void set_bus_health_window(uint32_t window_ms) { bus_window_ms_ = std::max<uint32_t>(window_ms, BUS_RATE_SLOTS * 1000); }
+  void set_bus_total_sensor(uint8_t direction, uint8_t counter, Sensor *s) { bus_total_sensors_[direction][counter] = s; }
+  void set_bus_rate_sensor(uint8_t direction, uint8_t counter, Sensor *s) { bus_rate_sensors_[direction][counter] = s; }
+#endif
+  uint32_t get_bus_counter(uint8_t direction, uint8_t counter) const {
+    return bus_counters_[direction][counter].load(std::memory_order_relaxed);
+  }
+#ifdef USE_AUTOTERM_DECODE_CACHE
+  void set_decode_cache_refresh_interval(uint32_t interval_ms) { decode_cache_refresh_ms_ = interval_ms; }
+  void set_decode_cache_hit_rate_sensor(Sensor *s) { decode_cache_hit_rate_sensor_ = s; }
+#endif
+#ifdef USE_AUTOTERM_COMMAND_WINDOW
+  void set_command_window(uint32_t window_ms) { command_window_ms_ = window_ms; }
+  void set_commands_coalesced_sensor(Sensor *s) { commands_coalesced_sensor_ = s; }
+  uint32_t get_commands_coalesced() const { return commands_coalesced_; }
+#endif
+#ifdef USE_AUTOTERM_RECONCILE
+  void set_reconcile_settle_time(uint32_t settle_ms) { reconcile_settle_ms_ = settle_ms; }
+  void set_reconcile_max_retries(uint8_t retries) { reconcile_max_retries_ = retries; }
+  uint32_t get_reconcile_corrections() const { return reconcile_corrections_; }
+  uint32_t get_commands_skipped() const { return commands_skipped_; }
+#endif
+  uint32_t get_ignition_count() const { return ignitions_; }
+  uint32_t get_ignition_failure_count() const { return ignition_failures_; }
+#ifdef USE_AUTOTERM_BATTERY_GOVERNOR
+  void set_battery_thresholds(float reduce_below, float block_below, float stop_below, float resume_above) {
+    battery_reduce_below_v_ = reduce_below;
+    battery_block_below_v_ = block_below;
+    battery_stop_below_v_ = stop_below;
+    battery_resume_above_v_ = resume_above;
+  }
+  void set_battery_filter_time(uint32_t filter_ms) { battery_filter_ms_ = std::max<uint32_t>(filter_ms, 1000); }
+  void set_battery_trend_time(uint32_t trend_ms) { battery_trend_ms_ = std::max<uint32_t>(trend_ms, 1000); }
+  void set_battery_lookahead(uint32_t lookahead_ms) { battery_lookahead_ms_ = lookahead_ms; }
+  void set_battery_step_interval(uint32_t interval_ms) { battery_step_interval_ms_ = interval_ms; }
+  void set_battery_min_level(uint8_t level) { battery_min_level_ = std::min<uint8_t>(level, 9); }
+  void set_battery_state_sensor(text_sensor::TextSensor *s) { battery_state_sensor_ = s; }
+  void set_battery_filtered_voltage_sensor(Sensor *s) { battery_filtered_sensor_ = s; }
+  void set_battery_trend_sensor(Sensor *s) { battery_trend_sensor_ = s; }
+  void add_on_battery_governor_callback(std::function<void(std::string, float)> &&cb) {
+    battery_governor_callback_.add(std::move(cb));
+  }
+  BatteryGovernorState get_battery_state() const { return battery_state_; }
+  uint8_t get_battery_level_cap() const { return battery_level_cap_; }
+  float get_battery_filtered_voltage() const { return battery_filtered_v_; }
+  float get_battery_trend() const { return battery_trend_vph_; }
+  uint32_t get_battery_blocked_starts() const { return battery_blocked_starts_; }
+#endif
+#ifdef USE_AUTOTERM_METRICS
+  void set_metrics_server(web_server_base::WebServerBase *base, const char *path);
+  void set_metrics_update_interval(uint32_t interval_ms) { metrics_interval_ms_ = interval_ms; }
+  // Zuletzt in loop() gerenderter Text; nullptr, solange noch nichts gerendert wurde
+  const char *get_metrics(size_t &length) const {
+    int8_t front = metrics_front_.load(std::memory_order_acquire);
+    if (front < 0)
+      return nullptr;
+    length = metrics_lengths_[front];
+    return metrics_buffers_[front];
+  }
+#endif
+#ifdef USE_AUTOTERM_TELEMETRY
+  void set_telemetry_target(const std::string &host, uint16_t port) {
+    telemetry_host_ = host;
+    telemetry_port_ = port;
+  }
+  void set_telemetry_batch_size(uint8_t records) {
+    telemetry_batch_size_ = std::max<uint8_t>(1, std::min(records, TELEMETRY_MAX_BATCH));
+  }
+  void set_telemetry_flush_interval(uint32_t interval_ms) { telemetry_flush_ms_ = interval_ms; }
+  void set_telemetry_dropped_sensor(Sensor *s) { telemetry_dropped_sensor_ = s; }
+  uint32_t get_telemetry_sent() const { return telemetry_sent_; }
+  uint32_t get_telemetry_dropped() const { return telemetry_dropped_; }
+#endif
+#ifdef USE_AUTOTERM_DECODE_CACHE
+  uint32_t get_decode_cache_hits(uint8_t slot) const { return decode_cache_hits_[slot]; }
+  uint32_t get_decode_cache_misses(uint8_t slot) const { return decode_cache_misses_[slot]; }
+#endif
+#ifdef USE_AUTOTERM_LATENCY
+  void set_latency_sensor(uint8_t direction, uint8_t stat, Sensor *s) { latency_sensors_[direction][stat] = s; }
+  void set_loop_time_max_sensor(Sensor *s) { loop_time_max_sensor_ = s; }
+  void set_bytes_per_loop_max_sensor(Sensor *s) { bytes_per_loop_max_sensor_ = s; }
+  void set_latency_update_interval(uint32_t interval_ms) { latency_update_interval_ms_ = interval_ms; }
+#endif
+#ifdef USE_AUTOTERM_PANEL_EMULATION
+  void set_panel_slot_interval(uint32_t interval_ms) { panel_slot_ms_ = std::max<uint32_t>(interval_ms, 500); }
+  void set_panel_switchover_sensor(Sensor *s) { panel_switchover_sensor_ = s; }
+  void set_panel_takeover_sensor(Sensor *s) { panel_takeover_sensor_ = s; }
+  bool is_panel_emulation_active() const { return panel_emulation_active_; }
+  uint32_t get_panel_switchover_ms() const { return panel_last_switchover_ms_; }
+  uint32_t get_panel_takeovers() const { return panel_takeovers_; }
+#endif
 
   // Sensor-Setter
   void set_internal_temp_sensor(Sensor *s) { internal_temp_sensor_ = s; }
@@ -141,21 +889,51 @@ class AutotermUART : public Component {
   void set_pump_frequency_sensor(Sensor *s) { pump_frequency_sensor_ = s; }
   void set_panel_temp_sensor(Sensor *s) {
     panel_temp_sensor_ = s;
-    if (s != nullptr && std::isfinite(panel_temp_last_value_c_)) {
-      s->publish_state(panel_temp_last_value_c_);
+    if (s != nullptr && panel_temp_last_dc_ != TEMP_DC_INVALID) {
+      s->publish_state(deci_to_float(panel_temp_last_dc_));
     }
   }
+#ifdef USE_AUTOTERM_STATUS_TEXT
   void set_status_text_sensor(text_sensor::TextSensor *s) { status_text_sensor_ = s; }
+#endif
+#ifdef USE_AUTOTERM_HEATER_MODEL
+  void set_heater_model_sensor(text_sensor::TextSensor *s) { heater_model_sensor_ = s; }
+  const char *get_firmware_version() const { return firmware_version_; }
+#endif
+
+  // Fehlerhistorie
+#ifdef USE_AUTOTERM_FAULT_HISTORY
+  void set_fault_clock(time::RealTimeClock *clock) { fault_clock_ = clock; }
+  void set_last_fault_sensor(text_sensor::TextSensor *s) { last_fault_sensor_ = s; }
+  void set_fault_count_sensor(Sensor *s) { fault_count_sensor_ = s; }
+  uint32_t get_fault_count() const { return fault_history_.total; }
+  uint8_t get_active_fault_code() const { return active_fault_code_; }
+#endif
+  void dump_fault_history();
+  void clear_fault_history();
+#ifdef USE_AUTOTERM_BENCHMARK
+  // Startet die Messung des Hot Path mit Frames aus dem Mitschnitt, Ergebnis als JSON-Zeile im Log
+  void run_benchmark(uint32_t iterations);
+#endif
+#ifdef USE_AUTOTERM_RUNTIME
   void set_runtime_hours_sensor(Sensor *s);
   void set_session_runtime_sensor(Sensor *s);
+#endif
 
+#ifdef USE_AUTOTERM_PANEL_OVERRIDE
   void set_panel_temp_override_sensor(Sensor *s);
+  void set_panel_temp_override_min_delta(float delta_c) { panel_temp_override_min_delta_c_ = delta_c; }
+  void set_panel_temp_override_keepalive(uint32_t interval_ms) { panel_temp_override_keepalive_ms_ = interval_ms; }
+#endif
+#ifdef USE_AUTOTERM_TEMP_SOURCE_SELECT
   void set_temp_source_select(AutotermTempSourceSelect *select);
   void set_temp_source_from_select(uint8_t source);
+#endif
   void apply_temp_source_from_settings(uint8_t source);
   uint8_t get_manual_temp_source() const { return manual_temp_source_active_ ? manual_temp_source_value_ : 0; }
   uint8_t get_effective_temp_source() const;
-  float get_temperature_for_source(uint8_t source) const;
+  float get_temperature_for_source(uint8_t source) const { return deci_to_float(get_temperature_for_source_dc(source)); }
+  int16_t get_temperature_for_source_dc(uint8_t source) const;
 
   // Neue Setter mit Rückreferenz
   void set_fan_level_number(AutotermFanLevelNumber *n) {
@@ -164,6 +942,53 @@ class AutotermUART : public Component {
   }
   void set_climate(AutotermClimate *climate);
 
+  // Snapshot: wird pro geparstem Status-/Settings-Frame genau einmal aktualisiert
+  const HeaterSnapshot &get_snapshot() const { return snapshot_; }
+  uint32_t get_snapshot_seq() const { return snapshot_.seq; }
+  bool snapshot_changed_since(uint32_t seq) const { return snapshot_.seq != seq; }
+
+#ifdef USE_AUTOTERM_PREHEAT
+  // Vorheizen
+  void set_preheat_clock(time::RealTimeClock *clock) { preheat_clock_ = clock; }
+  void set_preheat_status_sensor(text_sensor::TextSensor *s) { preheat_status_sensor_ = s; }
+  void set_preheat_level(uint8_t level) { preheat_level_ = std::min<uint8_t>(level, 9); }
+  void set_preheat_default_target(float target_c) { preheat_default_target_c_ = clamp_thermostat_target_(target_c); }
+  void set_preheat_default_rate(float rate_c_per_min) { preheat_default_rate_c_per_min_ = rate_c_per_min; }
+  void set_preheat_startup_time(uint32_t seconds) { preheat_startup_s_ = seconds; }
+  void set_preheat_max_lead_time(uint32_t seconds) { preheat_max_lead_s_ = seconds; }
+  void schedule_preheat(uint8_t hour, uint8_t minute, float target_c);
+  void cancel_preheat();
+  float get_preheat_default_target() const { return preheat_default_target_c_; }
+#endif
+
+  // Automation-Trigger
+#ifdef USE_AUTOTERM_ON_PHASE_CHANGE
+  void add_on_phase_change_callback(std::function<void(uint16_t, uint16_t)> &&cb) {
+    phase_change_callback_.add(std::move(cb));
+  }
+#endif
+#ifdef USE_AUTOTERM_ON_IGNITION_FAILED
+  void add_on_ignition_failed_callback(std::function<void(uint16_t)> &&cb) {
+    ignition_failed_callback_.add(std::move(cb));
+  }
+#endif
+#ifdef USE_AUTOTERM_ON_FRAME
+  void add_on_frame_callback(std::function<void(bool, uint8_t, const std::vector<uint8_t> &)> &&cb) {
+    frame_callback_.add(std::move(cb));
+  }
+#endif
+#ifdef USE_AUTOTERM_ON_DISPLAY_CONNECTED
+  void add_on_display_connected_callback(std::function<void()> &&cb) { display_connected_callback_.add(std::move(cb)); }
+#endif
+#ifdef USE_AUTOTERM_ON_DISPLAY_LOST
+  void add_on_display_lost_callback(std::function<void()> &&cb) { display_lost_callback_.add(std::move(cb)); }
+#endif
+#ifdef USE_AUTOTERM_ON_THERMOSTAT_CYCLE
+  void add_on_thermostat_cycle_callback(std::function<void(bool, float)> &&cb) {
+    thermostat_cycle_callback_.add(std::move(cb));
+  }
+#endif
+
   // Kommandos für Betriebsarten
   void send_standby();
   void send_power_mode(bool start, uint8_t level);
@@ -175,10 +1000,29 @@ class AutotermUART : public Component {
   void disable_thermostat_mode();
 
   void loop() override {
-    forward_and_sniff(uart_display_, uart_heater_, "display→heater", true);
-    forward_and_sniff(uart_heater_, uart_display_, "heater→display");
+#ifdef USE_AUTOTERM_LATENCY
+    uint32_t loop_start_us = micros();
+#endif
+    publish_rewrite_inputs_();
+    if (rx_task_running_) {
+      drain_rx_queue_();
+    } else {
+      forward_and_sniff(uart_display_, uart_heater_, "display→heater", true);
+      forward_and_sniff(uart_heater_, uart_display_, "heater→display");
+#ifdef USE_AUTOTERM_LATENCY
+      note_loop_bytes_();
+#endif
+    }
+    report_resyncs_();
+#ifdef USE_AUTOTERM_BATTERY_GOVERNOR
+    note_panel_blocked_starts_();
+#endif
 
     uint32_t now = millis();
+#ifdef USE_AUTOTERM_COMMAND_WINDOW
+    if (command_intents_pending_ != 0)
+      flush_command_intents_(now);
+#endif
     bool connected = uart_display_ != nullptr && (now - last_display_activity_) < 5000;
     if (connected != display_connected_state_) {
       display_connected_state_ = connected;
@@ -186,13 +1030,26 @@ class AutotermUART : public Component {
         ESP_LOGI("autoterm_uart", "Display connection detected");
         last_status_request_millis_ = now;
         last_settings_request_millis_ = now;
+#ifdef USE_AUTOTERM_PANEL_OVERRIDE
         last_panel_temp_send_millis_ = now;
+#endif
+#ifdef USE_AUTOTERM_ON_DISPLAY_CONNECTED
+        display_connected_callback_.call();
+#endif
       } else {
         ESP_LOGW("autoterm_uart", "Display connection lost, switching to autonomous mode");
+#ifdef USE_AUTOTERM_PANEL_OVERRIDE
         last_panel_temp_send_millis_ = 0;
+#endif
+#ifdef USE_AUTOTERM_ON_DISPLAY_LOST
+        display_lost_callback_.call();
+#endif
       }
     }
 
+#ifdef USE_AUTOTERM_PANEL_EMULATION
+    run_panel_emulation_(now);
+#else
     if (!connected) {
       if (now - last_status_request_millis_ >= 2000) {
         send_status_request();
@@ -202,23 +1059,99 @@ class AutotermUART : public Component {
         request_settings();
         last_settings_request_millis_ = now;
       }
+#ifdef USE_AUTOTERM_PANEL_OVERRIDE
       if (should_override_panel_temperature_() && std::isfinite(panel_temp_override_value_c_)) {
-        if (last_panel_temp_send_millis_ == 0 || (now - last_panel_temp_send_millis_) >= 1000) {
+        if (panel_temp_override_pending_ || last_panel_temp_send_millis_ == 0 ||
+            (now - last_panel_temp_send_millis_) >= panel_temp_override_keepalive_ms_) {
           send_panel_temperature_override_frame_();
           last_panel_temp_send_millis_ = now;
         }
       }
+#endif
     }
+#endif
 
+#ifdef USE_AUTOTERM_RUNTIME
     uint32_t runtime_now = millis();
     advance_runtime_time_(runtime_now);
     maybe_save_runtime_hours_(runtime_now);
+#endif
 
+#ifdef USE_AUTOTERM_THERMOSTAT
     if (thermostat_active_)
       evaluate_thermostat_control_();
+#endif
+
+#ifdef USE_AUTOTERM_HEATER_MODEL
+    // Versionsabfrage nur ohne Bedienteil, sonst kollidiert sie mit dessen Zyklus;
+    // mit Bedienteil wird dessen eigene Abfrage mitgelesen (handle_version_frame_)
+    if (!model_query_done_ && !connected && (now - model_query_millis_) >= 2000)
+      send_model_query_();
+#endif
+
+#ifdef USE_AUTOTERM_PREHEAT
+    if (preheat_scheduled_ && (now - preheat_last_evaluation_millis_) >= 30000)
+      evaluate_preheat_();
+#endif
+
+#ifdef USE_AUTOTERM_DECODE_CACHE
+    if ((now - decode_cache_last_publish_millis_) >= 60000)
+      publish_decode_cache_stats_(now);
+#endif
+
+#ifdef USE_AUTOTERM_BUS_HEALTH
+    if ((now - bus_last_slot_millis_) >= bus_window_ms_ / BUS_RATE_SLOTS)
+      update_bus_health_(now);
+#endif
+
+    if (climate_ != nullptr)
+      flush_climate_publish_(now);
+
+#ifdef USE_AUTOTERM_TELEMETRY
+    if (telemetry_count_ != 0 && (now - telemetry_first_millis_) >= telemetry_flush_ms_)
+      flush_telemetry_(now);
+#endif
+#ifdef USE_AUTOTERM_METRICS
+    if ((now - metrics_last_render_millis_) >= metrics_interval_ms_)
+      render_metrics_(now);
+#endif
+#ifdef USE_AUTOTERM_BENCHMARK
+    if (benchmark_stage_ != BENCH_OFF)
+      run_benchmark_chunk_();
+#endif
+
+#ifdef USE_AUTOTERM_LATENCY
+    uint32_t loop_us = micros() - loop_start_us;
+    loop_time_sum_us_ += loop_us;
+    loop_count_++;
+#ifdef USE_AUTOTERM_METRICS
+    loop_time_total_us_ += loop_us;
+    loop_iterations_total_++;
+#endif
+    if (loop_us > loop_time_max_us_)
+      loop_time_max_us_ = loop_us;
+    if ((now - latency_last_publish_millis_) >= latency_update_interval_ms_) {
+      latency_last_publish_millis_ = now;
+      latency_snapshot_requested_.store(true, std::memory_order_release);
+    }
+    if (latency_snapshot_ready_.load(std::memory_order_acquire))
+      publish_latency_stats_();
+#endif
   }
 
+  void on_shutdown() override { stop_rx_task_(); }
+#ifdef USE_HOST
+  ~AutotermUART() { stop_rx_task_(); }
+#endif
+
   void setup() override {
+    display_to_heater_buffer_.reserve(QueuedFrame::MAX_LENGTH);
+    heater_to_display_buffer_.reserve(QueuedFrame::MAX_LENGTH);
+    frame_scratch_[0].reserve(QueuedFrame::MAX_LENGTH);
+    frame_scratch_[1].reserve(QueuedFrame::MAX_LENGTH);
+    rx_task_frame_scratch_.reserve(QueuedFrame::MAX_LENGTH);
+
+#ifdef USE_AUTOTERM_RUNTIME
     if (global_preferences != nullptr) {
       runtime_hours_pref_ =
           global_preferences->make_preference<float>(fnv1_hash("autoterm_uart_runtime_hours"));
@@ -237,12 +1170,61 @@ class AutotermUART : public Component {
     session_runtime_last_published_ = NAN;
     publish_session_runtime_(true);
 
-    uint32_t now = millis();
-    last_runtime_millis_ = now;
-    last_runtime_save_millis_ = now;
+    last_runtime_millis_ = millis();
+    last_runtime_save_millis_ = last_runtime_millis_;
     runtime_tracking_initialized_ = true;
+#endif
+
+#ifdef USE_AUTOTERM_PREHEAT
+    if (global_preferences != nullptr) {
+      warmup_model_pref_ =
+          global_preferences->make_preference<WarmupModel>(fnv1_hash("autoterm_uart_warmup_model"));
+      if (!warmup_model_pref_.load(&warmup_model_))
+        warmup_model_ = WarmupModel{};
+    }
+    publish_preheat_status_();
+#endif
+
+#ifdef USE_AUTOTERM_BUS_HEALTH
+    if (global_preferences != nullptr) {
+      bus_counters_pref_ = global_preferences->make_preference<BusCounters>(fnv1_hash("autoterm_uart_bus_counters"));
+      BusCounters saved{};
+      if (bus_counters_pref_.load(&saved))
+        restore_bus_counters_(saved);
+    }
+    bus_last_slot_millis_ = millis();
+    bus_last_save_millis_ = bus_last_slot_millis_;
+#endif
+
+#ifdef USE_AUTOTERM_FAULT_HISTORY
+    if (global_preferences != nullptr) {
+      fault_history_pref_ =
+          global_preferences->make_preference<FaultHistory>(fnv1_hash("autoterm_uart_fault_history"));
+      fault_history_storage_ = true;
+      if (!fault_history_pref_.load(&fault_history_) || fault_history_.head >= FAULT_HISTORY_SIZE ||
+          fault_history_.count > FAULT_HISTORY_SIZE)
+        fault_history_ = FaultHistory{};
+    }
+    publish_fault_state_();
+#endif
+#ifdef USE_AUTOTERM_BATTERY_GOVERNOR
+    if (battery_state_sensor_ != nullptr)
+      battery_state_sensor_->publish_state(battery_governor_state_text(battery_state_));
+#endif
+#ifdef USE_AUTOTERM_PANEL_EMULATION
+    // Ein echtes Display bekommt einen vollen Zyklus Zeit, sich zu melden
+    panel_next_slot_millis_ = millis() + PANEL_CYCLE_LENGTH * panel_slot_ms_;
+#endif
+
+    publish_rewrite_inputs_();
+    if (rx_task_enabled_)
+      start_rx_task_();
 
     request_settings();
+#ifdef USE_AUTOTERM_HEATER_MODEL
+    publish_heater_model_();
+    model_query_millis_ = millis();
+#endif
   }
 
  protected:
@@ -251,64 +1233,161 @@ class AutotermUART : public Component {
     if (!src || !dst) return;
 
     auto &buffer = from_display ? display_to_heater_buffer_ : heater_to_display_buffer_;
+    uint8_t direction = from_display ? 0 : 1;
 
     while (src->available()) {
       uint8_t b;
       if (!src->read_byte(&b)) break;
 
       buffer.push_back(b);
+      last_byte_millis_[direction] = millis();
 
       if (from_display)
         last_display_activity_ = millis();
+#ifdef USE_AUTOTERM_LATENCY
+      bytes_this_loop_++;
+      if (buffer.size() == 1)
+        frame_start_us_[direction] = micros();
+#endif
+
+      extract_frames_(buffer, dst, tag, direction);
+    }
+
+    // Abgebrochener Frame: nach 50 ms Funkstille ab dem nächsten Header neu synchronisieren
+    if (!buffer.empty() && (millis() - last_byte_millis_[direction]) > 50) {
+      count_bus_(direction, BUS_ABORTED_FRAMES);
+      reject_frame_candidate_(buffer, dst, direction);
+      extract_frames_(buffer, dst, tag, direction);
+    }
+  }
 
-      // Schraube lose Bytes vor dem Header direkt durch
-      while (!buffer.empty() && buffer[0] != 0xAA) {
-        dst->write_byte(buffer[0]);
-        buffer.erase(buffer.begin());
+  // Zerlegt den Puffer in Frames. Ungültige Kandidaten (Header, Längentabelle, CRC) werden
+  // byteweise bis zum nächsten 0xAA durchgereicht; jeder Startpunkt wird höchstens
+  // einmal per CRC geprüft, der Aufwand pro Byte ist damit durch MAX_PAYLOAD begrenzt.
+  void extract_frames_(std::vector<uint8_t> &buffer, UARTComponent *dst, const char *tag, uint8_t direction) {
+    while (!buffer.empty()) {
+      if (buffer[0] != 0xAA) {
+        size_t skip = 1;
+        while (skip < buffer.size() && buffer[skip] != 0xAA)
+          skip++;
+        count_bus_(direction, BUS_STRAY_BYTES, skip);
+        skip_bytes_(buffer, skip, dst, direction);
+        continue;
       }
+      if (buffer.size() >= 2 && buffer[1] != 0x03 && buffer[1] != 0x04) {
+        reject_frame_candidate_(buffer, dst, direction);
+        continue;
+      }
+      if (buffer.size() < 3)
+        return;
 
-      while (true) {
-        if (buffer.empty())
-          break;
-        if (buffer[0] != 0xAA)
-          break;
-        if (buffer.size() < 3)
-          break;
-
-        uint8_t len = buffer[2];
-        size_t total = 5 + static_cast<size_t>(len) + 2;
-        if (buffer.size() < total)
-          break;
-
-        std::vector<uint8_t> frame(buffer.begin(), buffer.begin() + total);
-        process_frame_(std::move(frame), dst, tag, from_display);
-        buffer.erase(buffer.begin(), buffer.begin() + total);
+      uint8_t len = buffer[2];
+      if (len > MAX_PAYLOAD) {
+        reject_frame_candidate_(buffer, dst, direction);
+        continue;
+      }
+      if (buffer.size() < 5)
+        return;
+      if (!is_plausible_frame_length_(buffer[1], buffer[4], len)) {
+        reject_frame_candidate_(buffer, dst, direction);
+        continue;
       }
+      size_t total = 5 + static_cast<size_t>(len) + 2;
+      if (buffer.size() < total)
+        return;
 
-      if (buffer.size() > 64) {
-        for (uint8_t byte : buffer)
-          dst->write_byte(byte);
-        buffer.clear();
+      if (!validate_crc(buffer.data(), total)) {
+        count_bus_(direction, BUS_CRC_ERRORS);
+        reject_frame_candidate_(buffer, dst, direction);
+        continue;
       }
+
+      finish_resync_(direction);
+      std::vector<uint8_t> &frame = frame_scratch_[direction];
+      frame.assign(buffer.begin(), buffer.begin() + total);
+      buffer.erase(buffer.begin(), buffer.begin() + total);
+#ifdef USE_AUTOTERM_LATENCY
+      // Restbytes sind bereits jetzt da, nicht erst nach der Weiterleitung
+      uint32_t next_frame_start = micros();
+#endif
+      process_frame_(frame, dst, tag, direction == 0);
+#ifdef USE_AUTOTERM_LATENCY
+      if (!buffer.empty())
+        frame_start_us_[direction] = next_frame_start;
+#endif
+    }
+  }
+
+  bool is_plausible_frame_length_(uint8_t device, uint8_t command, uint8_t length) const {
+    bool known = false;
+    for (uint8_t i = 0; i < frame_length_rule_count_; i++) {
+      const FrameLengthRule &rule = frame_length_rules_[i];
+      if (rule.device != device || rule.command != command)
+        continue;
+      if (rule.length == length)
+        return true;
+      known = true;
     }
+    return !known && length <= unknown_command_max_length_;
+  }
+
+  // Verwirft den Header an Position 0 als Framestart und reicht ihn durch
+  void reject_frame_candidate_(std::vector<uint8_t> &buffer, UARTComponent *dst, uint8_t direction) {
+    begin_resync_(direction);
+    resync_frames_[direction]++;
+    skip_bytes_(buffer, 1, dst, direction);
+  }
+
+  void begin_resync_(uint8_t direction) {
+    if (in_resync_[direction])
+      return;
+    in_resync_[direction] = true;
+    resync_bytes_[direction] = 0;
+    resync_frames_[direction] = 0;
+    count_bus_(direction, BUS_RESYNCS);
+  }
+
+  void skip_bytes_(std::vector<uint8_t> &buffer, size_t count, UARTComponent *dst, uint8_t direction) {
+    begin_resync_(direction);
+    dst->write_array(buffer.data(), count);
+    buffer.erase(buffer.begin(), buffer.begin() + count);
+    resync_bytes_[direction] += count;
+#ifdef USE_AUTOTERM_LATENCY
+    if (!buffer.empty())
+      frame_start_us_[direction] = micros();
+#endif
+  }
+
+  void finish_resync_(uint8_t direction) {
+    if (!in_resync_[direction])
+      return;
+    in_resync_[direction] = false;
+    last_resync_bytes_[direction] = resync_bytes_[direction];
+    last_resync_frames_[direction] = resync_frames_[direction];
+    resync_reports_[direction]++;
   }
 
   // CRC16 (Modbus)
-  bool validate_crc(const std::vector<uint8_t> &data) {
-    if (data.size() < 3) return false;
-    uint16_t expected = crc16_modbus_(data.data(), data.size() - 2);
-    uint16_t recv_crc = (data[data.size() - 2] << 8) | data[data.size() - 1];
+  static bool validate_crc(const uint8_t *data, size_t length) {
+    if (length < 3) return false;
+    uint16_t expected = crc16_modbus_(data, length - 2);
+    uint16_t recv_crc = (data[length - 2] << 8) | data[length - 1];
     return expected == recv_crc;
   }
 
+  // Hex-Dump in einen Stack-Puffer, gekürzt wenn er nicht passt
+  static const char *format_hex_(const uint8_t *data, size_t length, char *out, size_t out_size) {
+    size_t pos = 0;
+    out[0] = '\0';
+    for (size_t i = 0; i < length && pos + 4 <= out_size; i++)
+      pos += snprintf(out + pos, out_size - pos, i == 0 ? "%02X" : " %02X", data[i]);
+    return out;
+  }
+
   void log_frame(const char *tag, const std::vector<uint8_t> &data) {
-    std::string hex;
-    char temp[6];
-    for (auto v : data) {
-      sprintf(temp, "%02X ", v);
-      hex += temp;
-    }
-    ESP_LOGD("autoterm_uart", "[%s] Frame (%u bytes): %s", tag, (unsigned)data.size(), hex.c_str());
+    char hex[3 * QueuedFrame::MAX_LENGTH + 1];
+    ESP_LOGD("autoterm_uart", "[%s] Frame (%u bytes): %s", tag, (unsigned)data.size(),
+             format_hex_(data.data(), data.size(), hex, sizeof(hex)));
   }
 
   void parse_status(const std::vector<uint8_t> &data);
@@ -319,33 +1398,169 @@ public:
  protected:
   void request_settings();
   void send_status_request();
+#ifdef USE_AUTOTERM_PANEL_OVERRIDE
   void send_panel_temperature_override_frame_();
+#endif
+#ifdef USE_AUTOTERM_PANEL_EMULATION
+  void note_display_panel_frame_(uint8_t command, uint32_t now);
+  void run_panel_emulation_(uint32_t now);
+  void send_panel_slot_(uint8_t command, uint32_t now);
+#endif
   bool is_panel_temperature_frame_(const std::vector<uint8_t> &frame) const;
   void handle_panel_temperature_frame_(const std::vector<uint8_t> &frame);
-  void process_frame_(std::vector<uint8_t> frame, UARTComponent *dst, const char *tag, bool from_display);
+#ifdef USE_AUTOTERM_HEATER_MODEL
+  void send_model_query_();
+  void handle_version_frame_(const std::vector<uint8_t> &frame);
+  void publish_heater_model_();
+#endif
+#ifdef USE_AUTOTERM_DECODE_CACHE
+  bool is_cached_payload_(const std::vector<uint8_t> &frame);
+  void invalidate_decode_cache_() {
+    for (auto &entry : decode_cache_)
+      entry.length = 0;
+  }
+  void publish_decode_cache_stats_(uint32_t now);
+#else
+  void invalidate_decode_cache_() {}
+#endif
+#ifdef USE_AUTOTERM_FAULT_HISTORY
+  void record_fault_(const StatusFrame &st);
+  void publish_fault_state_();
+#endif
+#ifdef USE_AUTOTERM_TELEMETRY
+  void push_telemetry_record_(uint8_t command, bool cached);
+  void flush_telemetry_(uint32_t now);
+  bool open_telemetry_socket_();
+#endif
+#ifdef USE_AUTOTERM_METRICS
+  void metrics_append_(const char *format, ...) __attribute__((format(printf, 2, 3)));
+  void render_metrics_(uint32_t now);
+#endif
+#ifdef USE_AUTOTERM_BATTERY_GOVERNOR
+  void update_battery_governor_(float voltage);
+  void enforce_battery_level_cap_();
+  void set_battery_state_(BatteryGovernorState state);
+  void publish_battery_state_();
+  bool battery_blocks_ignition_() const { return battery_state_ >= BatteryGovernorState::IGNITION_BLOCKED; }
+  // Eigene Kommandos 0x01/0x02 mit Stufe im letzten Payload-Byte; liefert false, wenn nicht gesendet werden darf
+  bool apply_battery_governor_(uint8_t command, uint8_t *payload, size_t length);
+  void note_panel_blocked_starts_();
+#endif
+  uint8_t capped_level_(uint8_t level) const {
+#ifdef USE_AUTOTERM_BATTERY_GOVERNOR
+    return std::min(level, battery_level_cap_);
+#else
+    return level;
+#endif
+  }
+  void process_frame_(std::vector<uint8_t> &frame, UARTComponent *dst, const char *tag, bool from_display);
+  void forward_frame_(std::vector<uint8_t> &frame, UARTComponent *dst, bool from_display);
+  void handle_frame_(const std::vector<uint8_t> &frame, const char *tag, bool from_display);
+  void report_resyncs_();
+  void write_heater_frame_(const uint8_t *data, size_t length);
+  void start_rx_task_();
+  void stop_rx_task_();
+  void rx_task_iteration_();
+  void publish_rewrite_inputs_();
+  void drain_rx_queue_();
+  void drain_tx_queue_();
+#ifdef USE_AUTOTERM_LATENCY
+  void note_loop_bytes_() {
+    bytes_total_ += bytes_this_loop_;
+    if (bytes_this_loop_ > bytes_per_loop_max_)
+      bytes_per_loop_max_ = bytes_this_loop_;
+    bytes_this_loop_ = 0;
+    if (latency_snapshot_requested_.load(std::memory_order_acquire))
+      take_latency_snapshot_();
+  }
+  void take_latency_snapshot_();
+  void publish_latency_stats_();
+#endif
+#ifdef USE_AUTOTERM_BUS_HEALTH
+  void update_bus_health_(uint32_t now);
+#endif
+  void count_bus_(uint8_t direction, BusCounter counter, uint32_t n = 1) {
+    bus_counters_[direction][counter].fetch_add(n, std::memory_order_relaxed);
+  }
+  BusCounters copy_bus_counters_() const;
+  void restore_bus_counters_(const BusCounters &counters);
+  void apply_temp_source_override_(std::vector<uint8_t> &frame, uint8_t desired);
+#ifdef USE_AUTOTERM_PANEL_OVERRIDE
   bool should_override_panel_temperature_() const;
-  void apply_temp_source_override_(std::vector<uint8_t> &frame);
   uint8_t compute_override_temperature_byte_() const;
+  void update_panel_temp_override_(float value);
+#endif
+  void flush_climate_publish_(uint32_t now);
   void update_crc_(std::vector<uint8_t> &frame);
-  bool send_command_(uint8_t command, const std::vector<uint8_t> &payload, const char *log_label);
-  uint16_t append_crc_(std::vector<uint8_t> &frame);
+  bool send_command_(uint8_t command, const uint8_t *payload, size_t length, const char *log_label);
+  void queue_command_(CommandClass command_class, uint8_t command, const uint8_t *payload, size_t length,
+                      const char *log_label);
+#ifdef USE_AUTOTERM_COMMAND_WINDOW
+  void flush_command_intents_(uint32_t now);
+  void cancel_command_intents_();
+#else
+  void cancel_command_intents_() {}
+#endif
+#ifdef USE_AUTOTERM_RECONCILE
+  bool record_desired_(DesiredRun run, uint8_t level, uint8_t sensor, uint8_t set_temp);
+  bool heater_matches_desired_() const;
+  void reconcile_desired_state_();
+  void release_desired_state_(const char *reason);
+#else
+  // Ohne Block reconcile wird jeder Befehl genau einmal gesendet
+  bool record_desired_(DesiredRun run, uint8_t level, uint8_t sensor, uint8_t set_temp) { return false; }
+  void reconcile_desired_state_() {}
+  void release_desired_state_(const char *reason) {}
+#endif
+  static bool is_heating_status_(uint16_t status_code) {
+    return (status_code & 0xFF00) == 0x0200 || status_code == 0x0300;
+  }
+  static bool is_fan_status_(uint16_t status_code) { return status_code == 0x0101 || status_code == 0x0323; }
+  static uint16_t append_crc_(uint8_t *frame, size_t length);
   static uint16_t crc16_modbus_(const uint8_t *data, size_t length);
+  static bool decode_status_(const std::vector<uint8_t> &data, StatusFrame &out);
+  static bool decode_settings_(const std::vector<uint8_t> &data, Settings &out);
+#ifdef USE_AUTOTERM_THERMOSTAT
   void evaluate_thermostat_control_(bool force = false);
   void handle_thermostat_status_update_(uint16_t status_code);
-  void send_thermostat_cooldown_(uint8_t source, uint8_t temp_byte);
+#endif
+  void handle_phase_change_(uint16_t status_code);
+  void commit_snapshot_() {
+    snapshot_.timestamp_ms = millis();
+    snapshot_.panel_temp_c = deci_to_float(panel_temp_last_dc_);
+    snapshot_.heater_running = heater_running_;
+    snapshot_.display_connected = display_connected_state_;
+    snapshot_.seq++;
+  }
+  static bool is_ignition_status_(uint16_t status_code) { return (status_code & 0xFF00) == 0x0200; }
   float clamp_thermostat_target_(float target) const;
+#ifdef USE_AUTOTERM_THERMOSTAT
+  void send_thermostat_cooldown_(uint8_t source, uint8_t temp_byte);
   float clamp_thermostat_hys_on_(float value) const;
   float clamp_thermostat_hys_off_(float value) const;
+#endif
+
+#ifdef USE_AUTOTERM_PREHEAT
+  void evaluate_preheat_();
+  void start_preheat_();
+  void publish_preheat_status_(int32_t start_minute_of_day = -1);
+  float warmup_rate_for_(uint8_t level, float outside_c) const;
+  void update_warmup_learning_(uint16_t status_code);
+  void save_warmup_model_();
+  static uint8_t warmup_outside_bin_(float outside_c);
+#endif
 
   void publish_temp_source_select_(uint8_t source);
   uint8_t clamp_temp_source_(uint8_t source) const;
   bool should_force_temp_source_() const;
   uint8_t map_source_to_heater_(uint8_t source) const;
-  void advance_runtime_time_(uint32_t now);
   void set_heater_running_state_(bool running);
+#ifdef USE_AUTOTERM_RUNTIME
+  void advance_runtime_time_(uint32_t now);
   void publish_runtime_hours_(bool force = false);
   void publish_session_runtime_(bool force = false);
   void maybe_save_runtime_hours_(uint32_t now, bool force = false);
+#endif
   bool is_heater_active_status_(uint16_t status_code) const;
 };
 
@@ -360,8 +1575,20 @@ class AutotermClimate : public climate::Climate {
  void set_default_temp_sensor(uint8_t sensor);
   void set_thermostat_hysteresis(float hys_on_c, float hys_off_c);
 
+  void set_label_language(LabelLanguage language);
+  LabelLanguage get_label_language() const { return label_language_; }
+  HeaterMode get_heater_mode() const { return heater_mode_; }
+
+  // Änderungen sammeln und höchstens einmal pro Loop bzw. min_publish_interval veröffentlichen
+  void set_min_publish_interval(uint32_t interval_ms) { min_publish_interval_ms_ = interval_ms; }
+  void set_suppressed_publish_sensor(Sensor *sensor) { suppressed_publish_sensor_ = sensor; }
+  void request_publish() { mark_dirty_(DIRTY_CURRENT, true); }
+  void flush_publish(uint32_t now);
+  uint32_t get_publish_count() const { return publish_count_; }
+  uint32_t get_suppressed_publish_count() const { return suppressed_publish_count_; }
+
   void handle_status_update(uint16_t status_code, float internal_temp);
-  void handle_settings_update(const AutotermUART::Settings &settings, bool from_display);
+  void handle_settings_update(const AutotermUART::Settings &settings, uint16_t status_code);
 
  protected:
   climate::ClimateTraits traits() override;
@@ -373,23 +1600,79 @@ class AutotermClimate : public climate::Climate {
  float current_temperature_c_{NAN};
  uint8_t fan_level_{4};
   uint8_t default_temp_sensor_{0x01};
-  std::string preset_mode_{"Leistungsmodus"};
+  HeaterMode heater_mode_{HeaterMode::POWER};
+  // Zuletzt genutzte Heizart; Vorgabe für Heizen/Auto ohne Preset nach Aus oder Lüften
+  HeaterMode last_heating_mode_{HeaterMode::POWER};
+  LabelLanguage label_language_{LabelLanguage::DE};
   float thermostat_hys_on_c_{2.0f};
   float thermostat_hys_off_c_{1.0f};
+  // Traits werden einmal aufgebaut. traits() liefert eine Kopie, und publish_state() kopiert dabei
+  // die std::set<std::string> der Presets und Lüfterstufen; deshalb wird gebündelt und gedrosselt veröffentlicht
+  climate::ClimateTraits traits_cache_;
+  bool traits_built_{false};
+
+  enum DirtyField : uint8_t {
+    DIRTY_MODE = 1 << 0,
+    DIRTY_ACTION = 1 << 1,
+    DIRTY_PRESET = 1 << 2,
+    DIRTY_FAN_MODE = 1 << 3,
+    DIRTY_TARGET = 1 << 4,
+    DIRTY_CURRENT = 1 << 5,
+  };
+  uint8_t dirty_{0};
+  bool publish_immediately_{false};
+  uint32_t min_publish_interval_ms_{1000};
+  uint32_t last_publish_millis_{0};
+  uint32_t publish_count_{0};
+  uint32_t suppressed_publish_count_{0};
+  Sensor *suppressed_publish_sensor_{nullptr};
+  uint32_t last_stats_publish_millis_{0};
+  void mark_dirty_(uint8_t fields, bool immediate = false);
+
+  // Übergangstabelle: (bisheriger Zustand, Ziel) → Befehlsfolge als Bitmaske
+  enum ControlStep : uint8_t {
+    STEP_DISABLE_THERMOSTAT = 1 << 0,
+    STEP_STANDBY = 1 << 1,
+    STEP_FAN_ONLY = 1 << 2,
+    STEP_POWER = 1 << 3,
+    STEP_HOLD = 1 << 4,
+    STEP_HEAT_FAN = 1 << 5,
+    STEP_THERMOSTAT = 1 << 6,
+  };
+  enum ControlState : uint8_t { STATE_OFF = 0, STATE_FAN_ONLY, STATE_HEATING, STATE_COUNT };
+  // Ziele: Aus, Lüften, danach Heizen mit HeaterMode NONE..THERMOSTAT
+  static constexpr uint8_t CONTROL_TARGET_COUNT = 2 + HEATER_MODE_COUNT;
+  static constexpr uint8_t CONTROL_TRANSITIONS[STATE_COUNT][CONTROL_TARGET_COUNT] = {
+      // aus Aus
+      {STEP_DISABLE_THERMOSTAT | STEP_STANDBY, STEP_DISABLE_THERMOSTAT | STEP_FAN_ONLY, STEP_DISABLE_THERMOSTAT,
+       STEP_DISABLE_THERMOSTAT | STEP_POWER, STEP_DISABLE_THERMOSTAT | STEP_HOLD,
+       STEP_DISABLE_THERMOSTAT | STEP_HEAT_FAN, STEP_THERMOSTAT},
+      // aus Lüften: vor jedem Heizstart erst Standby; Stufenwechsel im Lüften direkt per 0x23
+      {STEP_DISABLE_THERMOSTAT | STEP_STANDBY, STEP_DISABLE_THERMOSTAT | STEP_FAN_ONLY,
+       STEP_DISABLE_THERMOSTAT | STEP_STANDBY, STEP_DISABLE_THERMOSTAT | STEP_STANDBY | STEP_POWER,
+       STEP_DISABLE_THERMOSTAT | STEP_STANDBY | STEP_HOLD, STEP_DISABLE_THERMOSTAT | STEP_STANDBY | STEP_HEAT_FAN,
+       STEP_STANDBY | STEP_THERMOSTAT},
+      // aus Heizen: Lüften erst nach Standby, der Brenner muss vorher abkühlen
+      {STEP_DISABLE_THERMOSTAT | STEP_STANDBY, STEP_DISABLE_THERMOSTAT | STEP_STANDBY | STEP_FAN_ONLY,
+       STEP_DISABLE_THERMOSTAT, STEP_DISABLE_THERMOSTAT | STEP_POWER, STEP_DISABLE_THERMOSTAT | STEP_HOLD,
+       STEP_DISABLE_THERMOSTAT | STEP_HEAT_FAN, STEP_THERMOSTAT},
+  };
 
   static uint8_t clamp_level_(int level);
   static float clamp_temperature_(float temperature);
   static float clamp_hysteresis_on_(float value);
   static float clamp_hysteresis_off_(float value);
-  std::string fan_mode_label_from_level_(uint8_t level) const;
+  static bool assign_label_(optional<std::string> &field, const char *label);
+  void build_traits_();
+  uint8_t publish_labels_();
   uint8_t fan_mode_label_to_level_(const std::string &label) const;
-  std::string sanitize_preset_(const std::string &preset) const;
+  HeaterMode parse_preset_(const std::string &preset) const;
   uint8_t resolve_temp_sensor_() const;
   climate::ClimateMode deduce_mode_from_settings_(const AutotermUART::Settings &settings) const;
-  std::string deduce_preset_from_settings_(const AutotermUART::Settings &settings) const;
-  void apply_state_(climate::ClimateMode mode, const std::string &preset, uint8_t level, float target_temp);
+  HeaterMode deduce_heater_mode_from_settings_(const AutotermUART::Settings &settings) const;
+  void apply_state_(climate::ClimateMode mode, HeaterMode heater_mode, uint8_t level, float target_temp);
   void update_action_from_status_(uint16_t status_code);
-  static std::string preset_from_enum_(climate::ClimatePreset preset);
+  static HeaterMode heater_mode_from_enum_(climate::ClimatePreset preset);
   static uint8_t fan_level_from_enum_(climate::ClimateFanMode mode, uint8_t fallback_level);
 };
 
@@ -403,6 +1686,7 @@ void AutotermFanLevelNumber::control(float value) {
   if (parent_) parent_->send_fan_mode(true, (int)value);
 }
 
+#ifdef USE_AUTOTERM_TEMP_SOURCE_SELECT
 void AutotermTempSourceSelect::set_parent(AutotermUART *parent) {
   parent_ = parent;
   this->traits.set_options({"Intern", "Panel", "Extern", "Home Assistant"});
@@ -452,7 +1736,9 @@ void AutotermTempSourceSelect::control(const std::string &value) {
   }
   parent_->set_temp_source_from_select(src);
 }
+#endif
 
+#ifdef USE_AUTOTERM_RUNTIME
 void AutotermUART::set_runtime_hours_sensor(Sensor *s) {
   runtime_hours_sensor_ = s;
   if (runtime_hours_sensor_ != nullptr && runtime_loaded_)
@@ -464,18 +1750,34 @@ void AutotermUART::set_session_runtime_sensor(Sensor *s) {
   if (session_runtime_sensor_ != nullptr && runtime_tracking_initialized_)
     publish_session_runtime_(true);
 }
+#endif
 
+#ifdef USE_AUTOTERM_PANEL_OVERRIDE
 void AutotermUART::set_panel_temp_override_sensor(Sensor *s) {
   panel_temp_override_sensor_ = s;
   if (panel_temp_override_sensor_ != nullptr) {
     panel_temp_override_sensor_->add_on_state_callback([this](float value) {
-      this->panel_temp_override_value_c_ = value;
+      this->update_panel_temp_override_(value);
     });
     if (panel_temp_override_sensor_->has_state())
-      panel_temp_override_value_c_ = panel_temp_override_sensor_->state;
+      update_panel_temp_override_(panel_temp_override_sensor_->state);
   }
 }
 
+void AutotermUART::update_panel_temp_override_(float value) {
+  panel_temp_override_value_c_ = value;
+  panel_temp_override_dc_ = float_to_deci(value);
+  panel_temp_override_byte_ = compute_override_temperature_byte_();
+  if (!std::isfinite(value))
+    return;
+  // Kleine Schwankungen warten auf den nächsten Keepalive, größere Sprünge sofort senden
+  if (!std::isfinite(panel_temp_override_sent_c_) ||
+      std::fabs(value - panel_temp_override_sent_c_) >= panel_temp_override_min_delta_c_)
+    panel_temp_override_pending_ = true;
+}
+#endif
+
+#ifdef USE_AUTOTERM_TEMP_SOURCE_SELECT
 void AutotermUART::set_temp_source_select(AutotermTempSourceSelect *select) {
   temp_source_select_ = select;
   if (temp_source_select_ != nullptr) {
@@ -496,9 +1798,10 @@ void AutotermUART::set_temp_source_from_select(uint8_t source) {
   if (changed) {
     ESP_LOGI("autoterm_uart", "Temperature source set via select to %u", static_cast<unsigned>(clamped));
     if (climate_ != nullptr)
-      climate_->publish_state();
+      climate_->request_publish();
   }
 }
+#endif
 
 void AutotermUART::apply_temp_source_from_settings(uint8_t source) {
   uint8_t clamped = clamp_temp_source_(source);
@@ -515,37 +1818,36 @@ uint8_t AutotermUART::get_effective_temp_source() const {
   return 1;
 }
 
-float AutotermUART::get_temperature_for_source(uint8_t source) const {
+int16_t AutotermUART::get_temperature_for_source_dc(uint8_t source) const {
   uint8_t clamped = clamp_temp_source_(source);
-  float value = NAN;
+  int16_t value = TEMP_DC_INVALID;
   switch (clamped) {
     case 1:
-      value = last_internal_temp_c_;
+      value = last_internal_temp_dc_;
       break;
     case 2:
-      value = panel_temp_last_value_c_;
+      value = panel_temp_last_dc_;
       break;
     case 3:
-      value = last_external_temp_c_;
+      value = last_external_temp_dc_;
       break;
     case 4:
-      value = panel_temp_override_value_c_;
+      value = panel_temp_override_dc_;
       break;
     default:
-      value = last_internal_temp_c_;
+      value = last_internal_temp_dc_;
       break;
   }
-  if (std::isfinite(value))
+  if (value != TEMP_DC_INVALID)
     return value;
-  if (std::isfinite(last_internal_temp_c_))
-    return last_internal_temp_c_;
-  if (std::isfinite(panel_temp_last_value_c_))
-    return panel_temp_last_value_c_;
-  if (std::isfinite(last_external_temp_c_))
-    return last_external_temp_c_;
-  return NAN;
+  if (last_internal_temp_dc_ != TEMP_DC_INVALID)
+    return last_internal_temp_dc_;
+  if (panel_temp_last_dc_ != TEMP_DC_INVALID)
+    return panel_temp_last_dc_;
+  return last_external_temp_dc_;
 }
 
+#ifdef USE_AUTOTERM_RUNTIME
 void AutotermUART::advance_runtime_time_(uint32_t now) {
   if (!runtime_tracking_initialized_) {
     last_runtime_millis_ = now;
@@ -565,11 +1867,13 @@ void AutotermUART::advance_runtime_time_(uint32_t now) {
   publish_runtime_hours_();
   publish_session_runtime_();
 }
+#endif
 
 void AutotermUART::set_heater_running_state_(bool running) {
   if (heater_running_ == running)
     return;
 
+#ifdef USE_AUTOTERM_RUNTIME
   uint32_t now = millis();
   advance_runtime_time_(now);
   heater_running_ = running;
@@ -584,8 +1888,16 @@ void AutotermUART::set_heater_running_state_(bool running) {
     publish_session_runtime_(true);
     maybe_save_runtime_hours_(now, true);
   }
+#else
+  heater_running_ = running;
+#endif
+#ifdef USE_AUTOTERM_PREHEAT
+  if (!heater_running_)
+    save_warmup_model_();
+#endif
 }
 
+#ifdef USE_AUTOTERM_RUNTIME
 void AutotermUART::publish_runtime_hours_(bool force) {
   if (!runtime_loaded_ || runtime_hours_sensor_ == nullptr)
     return;
@@ -636,6 +1948,7 @@ void AutotermUART::maybe_save_runtime_hours_(uint32_t now, bool force) {
     last_runtime_save_millis_ = now;
   }
 }
+#endif
 
 bool AutotermUART::is_heater_active_status_(uint16_t status_code) const {
   if (status_code == 0x0000 || status_code == 0x0001)
@@ -643,53 +1956,562 @@ bool AutotermUART::is_heater_active_status_(uint16_t status_code) const {
   return true;
 }
 
-void AutotermUART::process_frame_(std::vector<uint8_t> frame, UARTComponent *dst, const char *tag, bool from_display) {
+void AutotermUART::process_frame_(std::vector<uint8_t> &frame, UARTComponent *dst, const char *tag, bool from_display) {
   if (frame.empty())
     return;
+#ifdef USE_AUTOTERM_BENCHMARK
+  if (benchmark_stage_ == BENCH_FRAMING)
+    return;
+  if (benchmark_stage_ == BENCH_REPLAY) {
+    replay_benchmark_frame_(frame, from_display);
+    return;
+  }
+#endif
 
-  bool valid = validate_crc(frame);
-  std::vector<uint8_t> outgoing = frame;
-
-  if (valid && from_display) {
-    if (is_panel_temperature_frame_(outgoing) && should_override_panel_temperature_()) {
-      if (outgoing.size() > 5) {
-        uint8_t original_byte = outgoing[5];
-        uint8_t override_byte = compute_override_temperature_byte_();
-        if (override_byte != original_byte) {
-          outgoing[5] = override_byte;
-          update_crc_(outgoing);
-          ESP_LOGD("autoterm_uart", "Panel temp override active: %u -> %u (source %.1f°C)",
-                   static_cast<unsigned>(original_byte),
-                   static_cast<unsigned>(override_byte),
-                   panel_temp_override_value_c_);
-        }
+  forward_frame_(frame, dst, from_display);
+
+  if (rx_task_running_) {
+    // Im RX-Task: Auswertung an loop() übergeben
+    QueuedFrame *slot = rx_queue_.acquire_write();
+    if (slot == nullptr || frame.size() > QueuedFrame::MAX_LENGTH) {
+      rx_queue_dropped_++;
+      return;
+    }
+    slot->length = static_cast<uint8_t>(frame.size());
+    slot->from_display = from_display;
+    memcpy(slot->data, frame.data(), frame.size());
+    rx_queue_.commit_write();
+    return;
+  }
+
+  handle_frame_(frame, tag, from_display);
+}
+
+void AutotermUART::forward_frame_(std::vector<uint8_t> &frame, UARTComponent *dst, bool from_display) {
+  uint8_t direction = from_display ? 0 : 1;
+  count_bus_(direction, BUS_FRAMES_OK);
+
+  if (from_display) {
+    uint16_t crc_before = (frame[frame.size() - 2] << 8) | frame[frame.size() - 1];
+    // Läuft im RX-Task: nur die von loop() veröffentlichte Kopie lesen, keinen Zustand schreiben
+    uint32_t inputs = rewrite_inputs_.load(std::memory_order_acquire);
+#ifdef USE_AUTOTERM_PANEL_OVERRIDE
+    uint8_t override_byte = inputs & 0xFF;
+    if (override_byte != REWRITE_NONE && is_panel_temperature_frame_(frame) && frame.size() > 5 &&
+        frame[5] != override_byte) {
+      ESP_LOGD("autoterm_uart", "Panel temp override active: %u -> %u", static_cast<unsigned>(frame[5]),
+               static_cast<unsigned>(override_byte));
+      frame[5] = override_byte;
+      update_crc_(frame);
+    }
+#endif
+    apply_temp_source_override_(frame, (inputs >> 8) & 0xFF);
+#ifdef USE_AUTOTERM_BATTERY_GOVERNOR
+    // Stufe des Bedienteils begrenzen; Startbefehl unter Zündsperre nicht weiterleiten.
+    // Nur Frames mit Nutzlast (len 6, Stufe in Byte 10), die Abfrage 0x02 ohne Nutzlast bleibt unberührt
+    if (frame[1] == 0x03 && (frame[4] == 0x01 || frame[4] == 0x02) && frame[2] == 6 && frame.size() == 13) {
+      if (frame[4] == 0x01 && ((inputs >> 24) & REWRITE_BLOCK_START)) {
+        battery_panel_blocked_.fetch_add(1, std::memory_order_relaxed);
+        return;
+      }
+      uint8_t cap = (inputs >> 16) & 0xFF;
+      if (frame[10] != 0xFF && frame[10] > cap) {
+        ESP_LOGD("autoterm_uart", "Batterie: Stufe %u -> %u (Bedienteil)", frame[10], cap);
+        frame[10] = cap;
+        update_crc_(frame);
       }
     }
-    apply_temp_source_override_(outgoing);
+#endif
+    if (((frame[frame.size() - 2] << 8) | frame[frame.size() - 1]) != crc_before)
+      count_bus_(direction, BUS_REWRITTEN_FRAMES);
   }
 
-  if (dst != nullptr && !outgoing.empty()) {
-    dst->write_array(outgoing.data(), outgoing.size());
+  if (dst != nullptr && !frame.empty()) {
+    dst->write_array(frame.data(), frame.size());
+#ifdef USE_AUTOTERM_LATENCY
+    uint32_t latency_us = micros() - frame_start_us_[direction];
+    latency_[direction].record(latency_us);
+#endif
     dst->flush();
   }
+}
+
+void AutotermUART::handle_frame_(const std::vector<uint8_t> &frame, const char *tag, bool from_display) {
+  if (is_panel_temperature_frame_(frame))
+    handle_panel_temperature_frame_(frame);
+  log_frame(tag, frame);
+#ifdef USE_AUTOTERM_ON_FRAME
+  frame_callback_.call(from_display, frame[4], frame);
+#endif
+  if (from_display && frame[4] == 0x03)
+    last_standby_millis_ = millis();
+#ifdef USE_AUTOTERM_HEATER_MODEL
+  if (!from_display && frame[4] == 0x06)
+    handle_version_frame_(frame);
+#endif
+#ifdef USE_AUTOTERM_PANEL_EMULATION
+  if (from_display)
+    note_display_panel_frame_(frame[4], millis());
+#endif
+  // Bedienung am Panel hat Vorrang vor dem eigenen Sollzustand
+  if (from_display && (frame[4] == 0x01 || frame[4] == 0x03 || frame[4] == 0x23 || (frame[4] == 0x02 && frame[2] > 0)))
+    release_desired_state_("Bedienteil");
+#ifdef USE_AUTOTERM_DECODE_CACHE
+  if (!from_display && is_cached_payload_(frame)) {
+#ifdef USE_AUTOTERM_TELEMETRY
+    push_telemetry_record_(frame[4], true);
+#endif
+    reconcile_desired_state_();
+    return;
+  }
+#endif
+  parse_status(frame);
+  parse_settings(frame, from_display);
+  if (!from_display && (frame[4] == 0x0F || frame[4] == 0x02))
+    reconcile_desired_state_();
+}
+
+#ifdef USE_AUTOTERM_DECODE_CACHE
+bool AutotermUART::is_cached_payload_(const std::vector<uint8_t> &frame) {
+  uint8_t slot;
+  if (frame[4] == 0x0F)
+    slot = DECODE_CACHE_STATUS;
+  else if (frame[4] == 0x02)
+    slot = DECODE_CACHE_SETTINGS;
+  else
+    return false;
+
+  // Die CRC ist bereits geprüft und dient als Schlüssel; memcmp schließt Kollisionen aus
+  DecodeCacheEntry &entry = decode_cache_[slot];
+  uint16_t crc = (frame[frame.size() - 2] << 8) | frame[frame.size() - 1];
+  uint32_t now = millis();
+  if (entry.length == frame.size() && entry.crc == crc && (now - entry.decoded_millis) < decode_cache_refresh_ms_ &&
+      memcmp(entry.frame, frame.data(), frame.size()) == 0) {
+    decode_cache_hits_[slot]++;
+    // Nur Zeitbezüge auffrischen; Sensoren und Thermostat sehen nichts Neues
+    snapshot_.timestamp_ms = now;
+    if (slot == DECODE_CACHE_STATUS) {
+#ifdef USE_AUTOTERM_PREHEAT
+      update_warmup_learning_(snapshot_.status_code);
+#endif
+#ifdef USE_AUTOTERM_BATTERY_GOVERNOR
+      update_battery_governor_(snapshot_.voltage_v);
+#endif
+      // Die angezeigte Ist-Temperatur kann aus einer anderen Quelle stammen (Fühlerwahl, Panel-Override)
+      if (climate_)
+        climate_->handle_status_update(snapshot_.status_code, snapshot_.internal_temp_c);
+    }
+    return true;
+  }
+
+  decode_cache_misses_[slot]++;
+  entry.crc = crc;
+  entry.length = frame.size() <= sizeof(entry.frame) ? static_cast<uint8_t>(frame.size()) : 0;
+  if (entry.length != 0)
+    memcpy(entry.frame, frame.data(), entry.length);
+  entry.decoded_millis = now;
+  return false;
+}
+
+void AutotermUART::publish_decode_cache_stats_(uint32_t now) {
+  decode_cache_last_publish_millis_ = now;
+  uint32_t hits = decode_cache_hits_[DECODE_CACHE_STATUS] + decode_cache_hits_[DECODE_CACHE_SETTINGS];
+  uint32_t total = hits + decode_cache_misses_[DECODE_CACHE_STATUS] + decode_cache_misses_[DECODE_CACHE_SETTINGS];
+  if (total == 0)
+    return;
+  ESP_LOGD("autoterm_uart", "Decode-Cache: Status %u/%u, Settings %u/%u Treffer",
+           static_cast<unsigned>(decode_cache_hits_[DECODE_CACHE_STATUS]),
+           static_cast<unsigned>(decode_cache_hits_[DECODE_CACHE_STATUS] + decode_cache_misses_[DECODE_CACHE_STATUS]),
+           static_cast<unsigned>(decode_cache_hits_[DECODE_CACHE_SETTINGS]),
+           static_cast<unsigned>(decode_cache_hits_[DECODE_CACHE_SETTINGS] +
+                                 decode_cache_misses_[DECODE_CACHE_SETTINGS]));
+  if (decode_cache_hit_rate_sensor_ != nullptr)
+    decode_cache_hit_rate_sensor_->publish_state(hits * 100.0f / total);
+}
+#endif
+
+#ifdef USE_AUTOTERM_TELEMETRY
+// Datensatz (36 Byte, little endian):
+//  0 u32 seq | 4 u32 millis | 8 u8 Kommando (0x0F/0x02) | 9 u8 Flags | 10 u16 Status
+// 12 i16 innen | 14 i16 außen | 16 i16 Wärmetauscher | 18 i16 Panel (0,1 °C) | 20 u16 Spannung (0,1 V)
+// 22 u16 Lüfter soll | 24 u16 Lüfter ist | 26 u16 Pumpe (0,01 Hz) | 28 u8 Fehler
+// 29 u8 Stufe | 30 u8 Solltemp | 31 u8 Sensor | 32 u8 Wartemodus | 33 u8 Laufzeit an | 34 u8 Laufzeit | 35 u8 Modell
+// Datagramm: "AT", u8 Version, u8 Anzahl, u32 bisher verworfene Datensätze, danach die Datensätze
+inline uint8_t *put_u16_le(uint8_t *p, uint16_t v) {
+  p[0] = v & 0xFF;
+  p[1] = v >> 8;
+  return p + 2;
+}
+
+inline uint8_t *put_u32_le(uint8_t *p, uint32_t v) {
+  p = put_u16_le(p, v & 0xFFFF);
+  return put_u16_le(p, v >> 16);
+}
+
+void AutotermUART::push_telemetry_record_(uint8_t command, bool cached) {
+  if (telemetry_port_ == 0)
+    return;
+  const StatusFrame &st = telemetry_status_;
+  uint8_t flags = (cached ? 0x01 : 0) | (snapshot_.status_valid ? 0x02 : 0) | (settings_valid_ ? 0x04 : 0) |
+                  (heater_running_ ? 0x08 : 0) | (display_connected_state_ ? 0x10 : 0);
+
+  uint8_t *p = telemetry_buffer_ + TELEMETRY_HEADER_SIZE + telemetry_count_ * TELEMETRY_RECORD_SIZE;
+  p = put_u32_le(p, telemetry_seq_++);
+  p = put_u32_le(p, millis());
+  *p++ = command;
+  *p++ = flags;
+  p = put_u16_le(p, st.status_code);
+  p = put_u16_le(p, static_cast<uint16_t>(st.internal_temp_dc));
+  p = put_u16_le(p, static_cast<uint16_t>(st.external_temp_dc));
+  p = put_u16_le(p, static_cast<uint16_t>(st.heater_temp_dc));
+  p = put_u16_le(p, static_cast<uint16_t>(panel_temp_last_dc_));
+  p = put_u16_le(p, st.voltage_dv);
+  p = put_u16_le(p, st.fan_set_rpm);
+  p = put_u16_le(p, st.fan_actual_rpm);
+  p = put_u16_le(p, st.pump_chz);
+  *p++ = st.error_code;
+  *p++ = settings_.power_level;
+  *p++ = settings_.set_temperature;
+  *p++ = settings_.temperature_source;
+  *p++ = settings_.wait_mode;
+  *p++ = settings_.use_work_time;
+  *p++ = settings_.work_time;
+#ifdef USE_AUTOTERM_HEATER_MODEL
+  *p++ = heater_model_id_;
+#else
+  *p++ = 0xFF;
+#endif
+
+  uint32_t now = millis();
+  if (telemetry_count_++ == 0)
+    telemetry_first_millis_ = now;
+  if (telemetry_count_ >= telemetry_batch_size_)
+    flush_telemetry_(now);
+}
+
+bool AutotermUART::open_telemetry_socket_() {
+  telemetry_addr_len_ = socket::set_sockaddr(reinterpret_cast<struct sockaddr *>(&telemetry_addr_),
+                                             sizeof(telemetry_addr_), telemetry_host_, telemetry_port_);
+  if (telemetry_addr_len_ == 0)
+    return false;
+  telemetry_socket_ = socket::socket_ip(SOCK_DGRAM, IPPROTO_IP);
+  if (telemetry_socket_ == nullptr)
+    return false;
+  // Nie blockieren: lieber einen Stapel verwerfen als den Bus-Takt verlieren
+  telemetry_socket_->setblocking(false);
+  ESP_LOGI("autoterm_uart", "Telemetrie an %s:%u", telemetry_host_.c_str(), telemetry_port_);
+  return true;
+}
+
+void AutotermUART::flush_telemetry_(uint32_t now) {
+  uint8_t count = telemetry_count_;
+  telemetry_count_ = 0;
+
+  bool sent = false;
+  const char *reason = "kein Netzwerk";
+  if (network::is_connected()) {
+    if (telemetry_socket_ == nullptr && !open_telemetry_socket_()) {
+      reason = "Socket nicht verfügbar";
+    } else {
+      uint8_t *p = telemetry_buffer_;
+      *p++ = 'A';
+      *p++ = 'T';
+      *p++ = TELEMETRY_VERSION;
+      *p++ = count;
+      put_u32_le(p, telemetry_dropped_);
+      size_t length = TELEMETRY_HEADER_SIZE + count * TELEMETRY_RECORD_SIZE;
+      sent = telemetry_socket_->sendto(telemetry_buffer_, length, 0,
+                                       reinterpret_cast<struct sockaddr *>(&telemetry_addr_),
+                                       telemetry_addr_len_) == static_cast<ssize_t>(length);
+      reason = "Sendepuffer voll";
+    }
+  }
+
+  if (sent) {
+    telemetry_sent_ += count;
+  } else {
+    // Kein Nachholen: Sequenznummern zeigen dem Empfänger die Lücke
+    telemetry_dropped_ += count;
+    if (telemetry_dropped_ == count || now - telemetry_last_error_log_millis_ >= 60000) {
+      telemetry_last_error_log_millis_ = now;
+      ESP_LOGW("autoterm_uart", "Telemetrie: %u Datensätze verworfen (%s, gesamt %u)", count, reason,
+               static_cast<unsigned>(telemetry_dropped_));
+    }
+  }
+  if (telemetry_dropped_sensor_ != nullptr && telemetry_dropped_ != telemetry_dropped_published_) {
+    telemetry_dropped_published_ = telemetry_dropped_;
+    telemetry_dropped_sensor_->publish_state(telemetry_dropped_);
+  }
+}
+#endif
+
+void AutotermUART::report_resyncs_() {
+  static const char *const DIRECTION_TAGS[2] = {"display→heater", "heater→display"};
+  for (uint8_t d = 0; d < 2; d++) {
+    uint32_t reports = resync_reports_[d].load(std::memory_order_acquire);
+    if (reports == resync_reported_[d])
+      continue;
+    resync_reported_[d] = reports;
+    // Reine Füllbytes ohne verworfenen Header sind kein Frameverlust
+    if (last_resync_frames_[d] == 0) {
+      ESP_LOGD("autoterm_uart", "[%s] %u lose Bytes durchgereicht", DIRECTION_TAGS[d],
+               static_cast<unsigned>(last_resync_bytes_[d]));
+      continue;
+    }
+    ESP_LOGW("autoterm_uart", "[%s] CRC/Header falsch, Resync nach %u Bytes (%u Framestarts verworfen, weitergeleitet)",
+             DIRECTION_TAGS[d], static_cast<unsigned>(last_resync_bytes_[d]),
+             static_cast<unsigned>(last_resync_frames_[d]));
+  }
+}
+
+void AutotermUART::write_heater_frame_(const uint8_t *data, size_t length) {
+  if (uart_heater_ == nullptr)
+    return;
+  count_bus_(0, BUS_INJECTED_FRAMES);
+  if (!rx_task_running_) {
+    uart_heater_->write_array(data, length);
+    uart_heater_->flush();
+    return;
+  }
+  // Der RX-Task besitzt die Heizungs-UART, eigene Kommandos laufen über tx_queue_
+  QueuedFrame *slot = tx_queue_.acquire_write();
+  if (slot == nullptr || length > QueuedFrame::MAX_LENGTH) {
+    tx_queue_dropped_++;
+    ESP_LOGW("autoterm_uart", "TX queue full, frame dropped");
+    return;
+  }
+  slot->length = static_cast<uint8_t>(length);
+  slot->from_display = false;
+  memcpy(slot->data, data, length);
+  tx_queue_.commit_write();
+}
+
+void AutotermUART::start_rx_task_() {
+#if defined(USE_ESP32)
+  rx_task_running_ = true;
+  BaseType_t ok = xTaskCreatePinnedToCore(
+      [](void *arg) {
+        auto *self = static_cast<AutotermUART *>(arg);
+        while (!self->rx_task_stop_.load(std::memory_order_relaxed)) {
+          self->rx_task_iteration_();
+          vTaskDelay(1);
+        }
+        vTaskDelete(nullptr);
+      },
+      "autoterm_rx", 4096, this, rx_task_priority_, nullptr, 1);
+  if (ok != pdPASS) {
+    rx_task_running_ = false;
+    ESP_LOGE("autoterm_uart", "Failed to start RX task, falling back to loop() forwarding");
+    return;
+  }
+#elif defined(USE_HOST)
+  rx_task_running_ = true;
+  rx_thread_ = std::thread([this]() {
+    while (!this->rx_task_stop_.load(std::memory_order_relaxed)) {
+      this->rx_task_iteration_();
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  });
+#else
+  ESP_LOGW("autoterm_uart", "RX task not supported on this platform, using loop() forwarding");
+  return;
+#endif
+  ESP_LOGI("autoterm_uart", "RX task started (priority %u)", static_cast<unsigned>(rx_task_priority_));
+}
+
+void AutotermUART::stop_rx_task_() {
+  if (!rx_task_running_)
+    return;
+  rx_task_stop_ = true;
+#ifdef USE_HOST
+  if (rx_thread_.joinable())
+    rx_thread_.join();
+  rx_task_running_ = false;
+#endif
+  // ESP32: der Task beendet sich beim nächsten Durchlauf selbst, danach folgt ohnehin der Neustart
+}
+
+void AutotermUART::publish_rewrite_inputs_() {
+  uint32_t panel_byte = REWRITE_NONE;
+#ifdef USE_AUTOTERM_PANEL_OVERRIDE
+  if (should_override_panel_temperature_())
+    panel_byte = panel_temp_override_byte_;
+#endif
+  uint32_t heater_source = should_force_temp_source_() ? map_source_to_heater_(manual_temp_source_value_) : REWRITE_NONE;
+  uint32_t level_cap = 9;
+  uint32_t flags = 0;
+#ifdef USE_AUTOTERM_BATTERY_GOVERNOR
+  level_cap = battery_level_cap_;
+  if (battery_blocks_ignition_())
+    flags |= REWRITE_BLOCK_START;
+#endif
+  rewrite_inputs_.store(panel_byte | (heater_source << 8) | (level_cap << 16) | (flags << 24),
+                        std::memory_order_release);
+}
+
+void AutotermUART::rx_task_iteration_() {
+  drain_tx_queue_();
+  forward_and_sniff(uart_display_, uart_heater_, "display→heater", true);
+  forward_and_sniff(uart_heater_, uart_display_, "heater→display");
+#ifdef USE_AUTOTERM_LATENCY
+  note_loop_bytes_();
+#endif
+}
 
-  if (!valid) {
-    ESP_LOGW("autoterm_uart", "[%s] CRC falsch, weitergeleitet", tag);
+#ifdef USE_AUTOTERM_LATENCY
+void AutotermUART::take_latency_snapshot_() {
+  // Läuft beim Besitzer der UARTs (RX-Task oder loop()); loop() liest die Kopie erst nach latency_snapshot_ready_
+  if (latency_snapshot_ready_.load(std::memory_order_acquire))
     return;
+  latency_snapshot_.latency[0] = latency_[0];
+  latency_snapshot_.latency[1] = latency_[1];
+  latency_snapshot_.bytes_total = bytes_total_;
+  latency_snapshot_.bytes_per_pass_max = bytes_per_loop_max_;
+  latency_[0].reset();
+  latency_[1].reset();
+  bytes_total_ = 0;
+  bytes_per_loop_max_ = 0;
+  latency_snapshot_requested_.store(false, std::memory_order_relaxed);
+  latency_snapshot_ready_.store(true, std::memory_order_release);
+}
+
+void AutotermUART::publish_latency_stats_() {
+  static const char *const DIRECTION_TAGS[2] = {"display→heater", "heater→display"};
+  const LatencySnapshot &snap = latency_snapshot_;
+
+  for (uint8_t d = 0; d < 2; d++) {
+    const LatencyHistogram &h = snap.latency[d];
+#ifdef USE_AUTOTERM_METRICS
+    LatencyHistogram &total = latency_total_[d];
+    for (uint8_t i = 0; i < LatencyHistogram::BUCKETS; i++)
+      total.counts[i] += h.counts[i];
+    total.total += h.total;
+    total.sum_us += h.sum_us;
+    total.max_us = std::max(total.max_us, h.max_us);
+#endif
+    float p50 = h.percentile_us(50) / 1000.0f;
+    float p99 = h.percentile_us(99) / 1000.0f;
+    float max = h.max_us / 1000.0f;
+    if (h.total > 0) {
+      if (latency_sensors_[d][LATENCY_P50] != nullptr)
+        latency_sensors_[d][LATENCY_P50]->publish_state(p50);
+      if (latency_sensors_[d][LATENCY_P99] != nullptr)
+        latency_sensors_[d][LATENCY_P99]->publish_state(p99);
+      if (latency_sensors_[d][LATENCY_MAX] != nullptr)
+        latency_sensors_[d][LATENCY_MAX]->publish_state(max);
+    }
+    ESP_LOGD("autoterm_uart", "[%s] Latenz: %u Frames p50=%.2fms p99=%.2fms max=%.2fms", DIRECTION_TAGS[d],
+             static_cast<unsigned>(h.total), p50, p99, max);
+    ESP_LOGD("autoterm_uart", "[%s] Buckets ≤0.25/0.5/1/2/4/8/16/32/64/128/256/>256ms: "
+             "%u %u %u %u %u %u %u %u %u %u %u %u", DIRECTION_TAGS[d],
+             (unsigned) h.counts[0], (unsigned) h.counts[1], (unsigned) h.counts[2], (unsigned) h.counts[3],
+             (unsigned) h.counts[4], (unsigned) h.counts[5], (unsigned) h.counts[6], (unsigned) h.counts[7],
+             (unsigned) h.counts[8], (unsigned) h.counts[9], (unsigned) h.counts[10], (unsigned) h.counts[11]);
+  }
+  // Mit RX-Task enthält loop() die Weiterleitung nicht; die Bytes zählen dann pro Task-Durchlauf
+  ESP_LOGD("autoterm_uart", "loop()%s: %u Durchläufe, avg=%uus max=%uus | Bytes: %u gesamt, max %u pro %s",
+           rx_task_running_ ? " ohne Weiterleitung" : "", static_cast<unsigned>(loop_count_),
+           static_cast<unsigned>(loop_count_ > 0 ? loop_time_sum_us_ / loop_count_ : 0),
+           static_cast<unsigned>(loop_time_max_us_), static_cast<unsigned>(snap.bytes_total),
+           static_cast<unsigned>(snap.bytes_per_pass_max), rx_task_running_ ? "Task-Durchlauf" : "loop()");
+
+  if (loop_time_max_sensor_ != nullptr)
+    loop_time_max_sensor_->publish_state(loop_time_max_us_ / 1000.0f);
+  if (bytes_per_loop_max_sensor_ != nullptr)
+    bytes_per_loop_max_sensor_->publish_state(snap.bytes_per_pass_max);
+
+  // Messfenster der Loop-Zeit neu starten; Histogramme und Bytes hat der Besitzer der UARTs schon zurückgesetzt
+  loop_time_max_us_ = 0;
+  loop_time_sum_us_ = 0;
+  loop_count_ = 0;
+  latency_snapshot_ready_.store(false, std::memory_order_release);
+}
+#endif
+
+AutotermUART::BusCounters AutotermUART::copy_bus_counters_() const {
+  BusCounters counters;
+  for (uint8_t d = 0; d < 2; d++) {
+    for (uint8_t c = 0; c < BUS_COUNTER_COUNT; c++)
+      counters.values[d][c] = bus_counters_[d][c].load(std::memory_order_relaxed);
+  }
+  return counters;
+}
+
+void AutotermUART::restore_bus_counters_(const BusCounters &counters) {
+  for (uint8_t d = 0; d < 2; d++) {
+    for (uint8_t c = 0; c < BUS_COUNTER_COUNT; c++)
+      bus_counters_[d][c].store(counters.values[d][c], std::memory_order_relaxed);
+  }
+}
+
+#ifdef USE_AUTOTERM_BUS_HEALTH
+void AutotermUART::update_bus_health_(uint32_t now) {
+  bus_last_slot_millis_ = now;
+
+  // Ältester Stand im Ring liegt ein volles Fenster zurück
+  uint8_t oldest = bus_history_filled_ < BUS_RATE_SLOTS ? 0 : bus_history_index_;
+  float window_min = static_cast<float>(bus_window_ms_) / 60000.0f;
+  if (bus_history_filled_ < BUS_RATE_SLOTS)
+    window_min = window_min * std::max<uint8_t>(bus_history_filled_, 1) / BUS_RATE_SLOTS;
+
+  BusCounters counters = copy_bus_counters_();
+  for (uint8_t d = 0; d < 2; d++) {
+    for (uint8_t c = 0; c < BUS_COUNTER_COUNT; c++) {
+      uint32_t total = counters.values[d][c];
+      if (bus_total_sensors_[d][c] != nullptr)
+        bus_total_sensors_[d][c]->publish_state(total);
+      if (bus_rate_sensors_[d][c] != nullptr) {
+        uint32_t base = bus_history_filled_ > 0 ? bus_history_[oldest][d][c] : total;
+        bus_rate_sensors_[d][c]->publish_state(static_cast<float>(total - base) / window_min);
+      }
+      bus_history_[bus_history_index_][d][c] = total;
+    }
+  }
+  bus_history_index_ = (bus_history_index_ + 1) % BUS_RATE_SLOTS;
+  if (bus_history_filled_ < BUS_RATE_SLOTS)
+    bus_history_filled_++;
+
+  if ((now - bus_last_save_millis_) >= 600000 && global_preferences != nullptr) {
+    bus_counters_pref_.save(&counters);
+    bus_last_save_millis_ = now;
   }
+}
+#endif
+
+void AutotermUART::drain_tx_queue_() {
+  const QueuedFrame *slot;
+  while ((slot = tx_queue_.peek_read()) != nullptr) {
+    if (uart_heater_ != nullptr) {
+      uart_heater_->write_array(slot->data, slot->length);
+      uart_heater_->flush();
+    }
+    tx_queue_.commit_read();
+  }
+}
 
-  if (is_panel_temperature_frame_(outgoing))
-    handle_panel_temperature_frame_(outgoing);
-  log_frame(tag, outgoing);
-  parse_status(outgoing);
-  parse_settings(outgoing, from_display);
+void AutotermUART::drain_rx_queue_() {
+  const QueuedFrame *slot;
+  while ((slot = rx_queue_.peek_read()) != nullptr) {
+    rx_task_frame_scratch_.assign(slot->data, slot->data + slot->length);
+    bool from_display = slot->from_display;
+    rx_queue_.commit_read();
+    handle_frame_(rx_task_frame_scratch_, from_display ? "display→heater" : "heater→display", from_display);
+  }
+  uint32_t dropped = rx_queue_dropped_.load(std::memory_order_relaxed);
+  if (dropped != rx_queue_dropped_reported_) {
+    ESP_LOGW("autoterm_uart", "RX queue: %u frames forwarded but not parsed",
+             static_cast<unsigned>(dropped - rx_queue_dropped_reported_));
+    rx_queue_dropped_reported_ = dropped;
+  }
 }
 
 void AutotermUART::publish_temp_source_select_(uint8_t source) {
+#ifdef USE_AUTOTERM_TEMP_SOURCE_SELECT
   if (temp_source_select_ != nullptr) {
     uint8_t clamped = clamp_temp_source_(source);
     temp_source_select_->publish_for_source(clamped);
   }
+#endif
 }
 
 uint8_t AutotermUART::clamp_temp_source_(uint8_t source) const {
@@ -719,8 +2541,8 @@ uint8_t AutotermUART::map_source_to_heater_(uint8_t source) const {
   }
 }
 
-void AutotermUART::apply_temp_source_override_(std::vector<uint8_t> &frame) {
-  if (!should_force_temp_source_())
+void AutotermUART::apply_temp_source_override_(std::vector<uint8_t> &frame, uint8_t desired) {
+  if (desired == REWRITE_NONE)
     return;
   if (frame.size() < 7)
     return;
@@ -732,7 +2554,6 @@ void AutotermUART::apply_temp_source_override_(std::vector<uint8_t> &frame) {
   size_t payload_index = 5;
   if (frame.size() <= payload_index + 2)
     return;
-  uint8_t desired = map_source_to_heater_(manual_temp_source_value_);
   uint8_t current = frame[payload_index + 2];
   if (current == desired)
     return;
@@ -742,6 +2563,7 @@ void AutotermUART::apply_temp_source_override_(std::vector<uint8_t> &frame) {
            static_cast<unsigned>(current), static_cast<unsigned>(desired));
 }
 
+#ifdef USE_AUTOTERM_PANEL_OVERRIDE
 bool AutotermUART::should_override_panel_temperature_() const {
   if (!std::isfinite(panel_temp_override_value_c_))
     return false;
@@ -765,6 +2587,7 @@ uint8_t AutotermUART::compute_override_temperature_byte_() const {
     value = 99.0f;
   return static_cast<uint8_t>(std::round(value));
 }
+#endif
 
 void AutotermUART::update_crc_(std::vector<uint8_t> &frame) {
   if (frame.size() < 3)
@@ -777,29 +2600,59 @@ void AutotermUART::update_crc_(std::vector<uint8_t> &frame) {
 // ===================
 // Bestehende Methoden
 // ===================
-void AutotermUART::parse_status(const std::vector<uint8_t> &data) {
-  if (data.size() < 24) return;
-  if (data[1] != 0x04 || data[4] != 0x0F) return;
+bool AutotermUART::decode_settings_(const std::vector<uint8_t> &data, Settings &out) {
+  if (data.size() < 13 || data[1] != 0x04 || data[4] != 0x02)
+    return false;
+  const uint8_t *p = &data[5];
+  out.use_work_time = p[0];
+  out.work_time = p[1];
+  out.temperature_source = p[2];
+  out.set_temperature = p[3];
+  out.wait_mode = p[4];
+  out.power_level = p[5];
+  return true;
+}
+
+bool AutotermUART::decode_status_(const std::vector<uint8_t> &data, StatusFrame &out) {
+  if (data.size() < 24)
+    return false;
+  if (data[1] != 0x04 || data[4] != 0x0F)
+    return false;
 
   const uint8_t *p = &data[5];
-  uint8_t s_hi = p[0];
-  uint8_t s_lo = p[1];
-  uint16_t status_code = (static_cast<uint16_t>(s_hi) << 8) | s_lo;
-  uint8_t fan_set_raw = p[11];
-  uint8_t fan_actual_raw = p[12];
-  uint8_t pump_raw = p[14];
-  float status_val = s_hi + (s_lo / 10.0f);
-  float internal_temp = (p[3] > 127 ? p[3] - 255 : p[3]);
-  float external_temp = (p[4] > 127 ? p[4] - 255 : p[4]);
-  float voltage = p[6] / 10.0f;
+  out.status_major = p[0];
+  out.status_minor = p[1];
+  out.status_code = (static_cast<uint16_t>(p[0]) << 8) | p[1];
+  // Temperaturen als Zweierkomplement: 0xFF = -1 °C
+  out.internal_temp_dc = static_cast<int16_t>(static_cast<int8_t>(p[3]) * 10);
+  out.external_temp_dc = static_cast<int16_t>(static_cast<int8_t>(p[4]) * 10);
+  out.voltage_dv = p[6];
   uint16_t heater_temp_raw = (static_cast<uint16_t>(p[7]) << 8) | p[8];
-  float heater_temp = NAN;
-  if (heater_temp_raw != 0xFFFF)
-    heater_temp = (static_cast<float>(heater_temp_raw) - 0x100)/2;
-  float fan_set_rpm = fan_set_raw * 60.0f;
-  float fan_actual_rpm = fan_actual_raw * 60.0f;
-  float pump_freq = pump_raw / 100.0f;
+  // Rohwert in 0,5 °C mit Offset 0x100 → 0,1 °C; was nicht in int16 passt, gilt als ungültig
+  int32_t heater_temp_dc = (static_cast<int32_t>(heater_temp_raw) - 0x100) * 5;
+  out.heater_temp_dc = heater_temp_raw == 0xFFFF || heater_temp_dc <= TEMP_DC_INVALID || heater_temp_dc > INT16_MAX
+                           ? TEMP_DC_INVALID
+                           : static_cast<int16_t>(heater_temp_dc);
+  out.fan_set_rpm = static_cast<uint16_t>(p[11]) * 60;
+  out.fan_actual_rpm = static_cast<uint16_t>(p[12]) * 60;
+  out.pump_chz = p[14];
+  out.error_code = p[2];  // laut Protokollbeschreibung, im Mitschnitt stets 0
+  return true;
+}
 
+void AutotermUART::parse_status(const std::vector<uint8_t> &data) {
+  StatusFrame st;
+  if (!decode_status_(data, st))
+    return;
+#ifdef USE_AUTOTERM_BENCHMARK
+  ProfileScope profile(call_profile_[PROFILE_PARSE_STATUS]);
+#endif
+  uint16_t status_code = st.status_code;
+  uint8_t s_hi = st.status_major;
+  uint8_t s_lo = st.status_minor;
+
+  char status_buf[sizeof(snapshot_.status_text)];
+#ifdef USE_AUTOTERM_STATUS_TEXT
   const char *status_txt = "Unbekannt";
   switch (status_code) {
     case 0x0001:
@@ -843,62 +2696,123 @@ void AutotermUART::parse_status(const std::vector<uint8_t> &data) {
       break;
     default:
       // Wenn unbekannter Status, erweitere Textausgabe um HEX-Werte
-      static char unknown_buf[32];
-      snprintf(unknown_buf, sizeof(unknown_buf), "Unbekannt (0x%02X%02X)", s_hi, s_lo);
-      status_txt = unknown_buf;
+      snprintf(status_buf, sizeof(status_buf), "Unbekannt (0x%02X%02X)", s_hi, s_lo);
+      status_txt = status_buf;
       break;
   }
-
+#else
+  // Ohne Status-Textsensor nur der HEX-Code (spart die Klartext-Tabelle)
+  snprintf(status_buf, sizeof(status_buf), "0x%02X%02X", s_hi, s_lo);
+  const char *status_txt = status_buf;
+#endif
+
+  char heater_txt[8] = "--";
+  if (st.heater_temp_dc != TEMP_DC_INVALID)
+    snprintf(heater_txt, sizeof(heater_txt), "%d", st.heater_temp_dc / 10);
   ESP_LOGD("autoterm_uart",
-           "Status: %s (0x%02X%02X) | U=%.1fV | Heater %.0f°C | Fan %.0f/%.0f rpm | Pump %.2f Hz",
-           status_txt, s_hi, s_lo, voltage, heater_temp, fan_actual_rpm, fan_set_rpm, pump_freq);
+           "Status: %s (0x%02X%02X) | U=%u.%uV | Heater %s°C | Fan %u/%u rpm | Pump %u.%02u Hz",
+           status_txt, s_hi, s_lo, st.voltage_dv / 10, st.voltage_dv % 10, heater_txt, st.fan_actual_rpm,
+           st.fan_set_rpm, st.pump_chz / 100, st.pump_chz % 100);
+
+#ifdef USE_AUTOTERM_FAULT_HISTORY
+  // Ein Eintrag pro Auftreten, nicht pro Statusframe
+  if (st.error_code != active_fault_code_) {
+    if (st.error_code != 0)
+      record_fault_(st);
+    active_fault_code_ = st.error_code;
+  }
+#endif
 
   set_heater_running_state_(is_heater_active_status_(status_code));
+  handle_phase_change_(status_code);
+
+  last_internal_temp_dc_ = st.internal_temp_dc;
+  last_external_temp_dc_ = st.external_temp_dc;
+
+  // Publish-Grenze: ab hier float
+  float internal_temp = deci_to_float(st.internal_temp_dc);
+  float external_temp = deci_to_float(st.external_temp_dc);
+  float heater_temp = deci_to_float(st.heater_temp_dc);
+  float voltage = st.voltage_dv / 10.0f;
+  float status_val = (s_hi * 10 + s_lo) / 10.0f;
+  float fan_set_rpm = st.fan_set_rpm;
+  float fan_actual_rpm = st.fan_actual_rpm;
+  float pump_freq = st.pump_chz / 100.0f;
 
   if (internal_temp_sensor_) internal_temp_sensor_->publish_state(internal_temp);
   if (external_temp_sensor_) external_temp_sensor_->publish_state(external_temp);
   if (heater_temp_sensor_) heater_temp_sensor_->publish_state(heater_temp);
 
-  last_internal_temp_c_ = internal_temp;
-  last_external_temp_c_ = external_temp;
+#ifdef USE_AUTOTERM_THERMOSTAT
   handle_thermostat_status_update_(status_code);
   if (thermostat_active_ && !thermostat_waiting_for_idle_)
     evaluate_thermostat_control_(true);
+#endif
+#ifdef USE_AUTOTERM_PREHEAT
+  update_warmup_learning_(status_code);
+#endif
 
   if (voltage_sensor_) voltage_sensor_->publish_state(voltage);
   if (status_sensor_) status_sensor_->publish_state(status_val);
-  if (status_text_sensor_) status_text_sensor_->publish_state(status_txt);
+#ifdef USE_AUTOTERM_STATUS_TEXT
+  // Langer Klartext passt nicht in den SSO-Puffer: nur bei Statuswechsel veröffentlichen
+  if (status_text_sensor_ && status_code != status_text_published_code_) {
+    status_text_published_code_ = status_code;
+    status_text_sensor_->publish_state(status_txt);
+  }
+#endif
   if (fan_speed_set_sensor_) fan_speed_set_sensor_->publish_state(fan_set_rpm);
   if (fan_speed_actual_sensor_) fan_speed_actual_sensor_->publish_state(fan_actual_rpm);
   if (pump_frequency_sensor_) pump_frequency_sensor_->publish_state(pump_freq);
+
+  snapshot_.status_valid = true;
+  snapshot_.status_code = status_code;
+  snapshot_.fault_code = st.error_code;
+  snprintf(snapshot_.status_text, sizeof(snapshot_.status_text), "%s", status_txt);
+  snapshot_.internal_temp_c = internal_temp;
+  snapshot_.external_temp_c = external_temp;
+  snapshot_.heater_temp_c = heater_temp;
+  snapshot_.voltage_v = voltage;
+  snapshot_.fan_speed_set_rpm = fan_set_rpm;
+  snapshot_.fan_speed_actual_rpm = fan_actual_rpm;
+  snapshot_.pump_frequency_hz = pump_freq;
+  commit_snapshot_();
+#ifdef USE_AUTOTERM_TELEMETRY
+  telemetry_status_ = st;
+  push_telemetry_record_(0x0F, false);
+#endif
+#ifdef USE_AUTOTERM_BATTERY_GOVERNOR
+  update_battery_governor_(voltage);
+#endif
+
   if (climate_) climate_->handle_status_update(status_code, internal_temp);
 }
 
 void AutotermUART::parse_settings(const std::vector<uint8_t> &data, bool from_display) {
-  if (data.size() < 13) return;
-  if (data.size() >= 5 && data[1] == 0x04 && data[4] == 0x02) {
-    const uint8_t *p = &data[5];
-    uint8_t use_work_time = p[0];
-    uint8_t work_time = p[1];
-    uint8_t temp_source = p[2];
-    uint8_t set_temp = p[3];
-    uint8_t wait_mode = p[4];
-    uint8_t power_level = p[5];
-
+  Settings s{};
+  if (decode_settings_(data, s)) {
+#ifdef USE_AUTOTERM_BENCHMARK
+    ProfileScope profile(call_profile_[PROFILE_PARSE_SETTINGS]);
+#endif
     ESP_LOGD("autoterm_uart",
              "Settings: use_work_time=%d work_time=%d temp_src=%d set_temp=%d wait_mode=%d level=%d",
-             use_work_time, work_time, temp_source, set_temp, wait_mode, power_level);
-    Settings s{};
-    s.use_work_time = use_work_time;
-    s.work_time = work_time;
-    s.temperature_source = temp_source;
-    s.set_temperature = set_temp;
-    s.wait_mode = wait_mode;
-    s.power_level = power_level;
+             s.use_work_time, s.work_time, s.temperature_source, s.set_temperature, s.wait_mode, s.power_level);
     settings_ = s;
     settings_valid_ = true;
     apply_temp_source_from_settings(s.temperature_source);
-    if (climate_) climate_->handle_settings_update(settings_, from_display);
+    snapshot_.settings_valid = true;
+    snapshot_.settings = settings_;
+    commit_snapshot_();
+#ifdef USE_AUTOTERM_TELEMETRY
+    push_telemetry_record_(0x02, false);
+#endif
+    // Ein noch nicht erreichter Sollzustand hat Vorrang; sonst zeigt das Climate, was die Heizung meldet
+#ifdef USE_AUTOTERM_RECONCILE
+    if (desired_.active && !reconcile_gave_up_)
+      return;
+#endif
+    if (climate_)
+      climate_->handle_settings_update(settings_, snapshot_.status_valid ? snapshot_.status_code : 0xFFFF);
   }
 }
 
@@ -932,11 +2846,10 @@ void AutotermUART::handle_panel_temperature_frame_(const std::vector<uint8_t> &f
     return;
 
   uint8_t raw = frame[5];
-  float temperature_c = static_cast<float>(raw);
-  panel_temp_last_value_c_ = temperature_c;
+  panel_temp_last_dc_ = static_cast<int16_t>(raw * 10);
 
   if (panel_temp_sensor_ != nullptr)
-    panel_temp_sensor_->publish_state(temperature_c);
+    panel_temp_sensor_->publish_state(static_cast<float>(raw));
 }
 
 uint16_t AutotermUART::crc16_modbus_(const uint8_t *data, size_t length) {
@@ -953,101 +2866,468 @@ uint16_t AutotermUART::crc16_modbus_(const uint8_t *data, size_t length) {
   return crc;
 }
 
-uint16_t AutotermUART::append_crc_(std::vector<uint8_t> &frame) {
-  uint16_t crc = crc16_modbus_(frame.data(), frame.size());
-  frame.push_back((crc >> 8) & 0xFF);
-  frame.push_back(crc & 0xFF);
+uint16_t AutotermUART::append_crc_(uint8_t *frame, size_t length) {
+  uint16_t crc = crc16_modbus_(frame, length);
+  frame[length] = (crc >> 8) & 0xFF;
+  frame[length + 1] = crc & 0xFF;
   return crc;
 }
 
-bool AutotermUART::send_command_(uint8_t command, const std::vector<uint8_t> &payload, const char *log_label) {
+bool AutotermUART::send_command_(uint8_t command, const uint8_t *payload, size_t length, const char *log_label) {
   if (!uart_heater_) {
     ESP_LOGW("autoterm_uart", "UART heater not configured, skipping command 0x%02X", command);
     return false;
   }
+  if (length > MAX_PAYLOAD)
+    return false;
 
-  std::vector<uint8_t> frame;
-  frame.reserve(5 + payload.size() + 2);
-  frame.push_back(0xAA);
-  frame.push_back(0x03);
-  frame.push_back(static_cast<uint8_t>(payload.size()));
-  frame.push_back(0x00);
-  frame.push_back(command);
-  frame.insert(frame.end(), payload.begin(), payload.end());
-
-  uint16_t crc = append_crc_(frame);
+  uint8_t frame[5 + MAX_PAYLOAD + 2];
+  frame[0] = 0xAA;
+  frame[1] = 0x03;
+  frame[2] = static_cast<uint8_t>(length);
+  frame[3] = 0x00;
+  frame[4] = command;
+  if (length > 0)
+    memcpy(frame + 5, payload, length);
+#ifdef USE_AUTOTERM_BATTERY_GOVERNOR
+  if (!apply_battery_governor_(command, frame + 5, length))
+    return false;
+#endif
 
-  uart_heater_->write_array(frame);
-  uart_heater_->flush();
+  uint16_t crc = append_crc_(frame, 5 + length);
 
-  std::string payload_hex;
-  char temp[4];
-  for (auto byte : payload) {
-    snprintf(temp, sizeof(temp), "%02X", byte);
-    payload_hex += temp;
-    payload_hex += ' ';
-  }
-  if (!payload_hex.empty())
-    payload_hex.pop_back();
+  write_heater_frame_(frame, 5 + length + 2);
 
+  char payload_hex[3 * MAX_PAYLOAD + 1];
   ESP_LOGD("autoterm_uart", "Sent %s (cmd=0x%02X len=%u payload=[%s] crc=%04X)",
            log_label != nullptr ? log_label : "frame",
-           command, static_cast<unsigned>(payload.size()), payload_hex.c_str(), crc);
+           command, static_cast<unsigned>(length), format_hex_(payload, length, payload_hex, sizeof(payload_hex)), crc);
   return true;
 }
 
-void AutotermUART::send_standby() {
-  send_command_(0x03, {}, "mode.standby");
-}
+#ifdef USE_AUTOTERM_COMMAND_WINDOW
+void AutotermUART::queue_command_(CommandClass command_class, uint8_t command, const uint8_t *payload, size_t length,
+                                  const char *log_label) {
+  if (command_window_ms_ == 0 || length > INTENT_MAX_PAYLOAD) {
+    send_command_(command, payload, length, log_label);
+    return;
+  }
+  uint32_t now = millis();
+  CommandIntent &intent = command_intents_[command_class];
+  if (intent.pending) {
+    commands_coalesced_++;
+    ESP_LOGV("autoterm_uart", "%s ersetzt durch %s", intent.label, log_label);
+  } else {
+    intent.pending = true;
+    intent.first_millis = now;
+    command_intents_pending_++;
+  }
+  intent.command = command;
+  intent.length = static_cast<uint8_t>(length);
+  if (length > 0)
+    memcpy(intent.payload, payload, length);
+  intent.label = log_label;
+  intent.last_millis = now;
+}
+
+void AutotermUART::flush_command_intents_(uint32_t now) {
+  // Fällig nach window Ruhe; beim Dauerziehen spätestens nach 4 × window
+  while (command_intents_pending_ != 0) {
+    CommandIntent *next = nullptr;
+    for (auto &intent : command_intents_) {
+      if (!intent.pending)
+        continue;
+      bool due = (now - intent.last_millis) >= command_window_ms_ || (now - intent.first_millis) >= 4 * command_window_ms_;
+      // Reihenfolge der letzten Änderung beibehalten (z. B. Start vor Sollwert)
+      if (due && (next == nullptr || static_cast<int32_t>(intent.last_millis - next->last_millis) < 0))
+        next = &intent;
+    }
+    if (next == nullptr)
+      break;
+    next->pending = false;
+    command_intents_pending_--;
+    send_command_(next->command, next->payload, next->length, next->label);
+  }
+  if (commands_coalesced_sensor_ != nullptr && commands_coalesced_ != commands_coalesced_published_) {
+    commands_coalesced_published_ = commands_coalesced_;
+    commands_coalesced_sensor_->publish_state(commands_coalesced_);
+  }
+}
+
+void AutotermUART::cancel_command_intents_() {
+  for (auto &intent : command_intents_) {
+    if (!intent.pending)
+      continue;
+    intent.pending = false;
+    commands_coalesced_++;
+    ESP_LOGD("autoterm_uart", "%s durch Standby verworfen", intent.label);
+  }
+  command_intents_pending_ = 0;
+}
+#else
+void AutotermUART::queue_command_(CommandClass command_class, uint8_t command, const uint8_t *payload, size_t length,
+                                  const char *log_label) {
+  // Ohne command_window geht jeder Befehl sofort raus
+  send_command_(command, payload, length, log_label);
+}
+#endif
+
+#ifdef USE_AUTOTERM_RECONCILE
+bool AutotermUART::record_desired_(DesiredRun run, uint8_t level, uint8_t sensor, uint8_t set_temp) {
+  // Korrekturen und Thermostat-Schaltungen ändern den Sollzustand nicht
+  if (reconcile_resend_ || thermostat_active_)
+    return false;
+  // Ein ausdrücklicher Befehl hebt die Sperre nach einer Fehlzündung auf
+  ignition_failed_latched_ = false;
+  DesiredState next{true, run, level, sensor, set_temp};
+  bool changed = !desired_.active || desired_.run != run || desired_.level != level || desired_.sensor != sensor ||
+                 desired_.set_temp != set_temp;
+  desired_ = next;
+  reconcile_last_action_millis_ = millis();
+  if (changed) {
+    reconcile_attempts_ = 0;
+    reconcile_gave_up_ = false;
+  }
+  // Meldet die Heizung diesen Zustand schon, entfällt der Befehl; Thermostat und Standby senden immer
+  if (run == DesiredRun::OFF || run == DesiredRun::FAN)
+    return false;
+#ifdef USE_AUTOTERM_COMMAND_WINDOW
+  // Wartet noch eine ältere Absicht im Fenster, muss der neue Befehl sie ersetzen statt zu entfallen
+  if (command_intents_pending_ != 0)
+    return false;
+#endif
+  if (!snapshot_.status_valid || !is_heating_status_(snapshot_.status_code) || !heater_matches_desired_())
+    return false;
+  commands_skipped_++;
+  ESP_LOGD("autoterm_uart", "Heizung meldet Sollzustand bereits, Befehl entfällt");
+  return true;
+}
+
+bool AutotermUART::heater_matches_desired_() const {
+  if (!settings_valid_)
+    return false;
+  switch (desired_.run) {
+    case DesiredRun::POWER:
+      return settings_.temperature_source == 0x04 && settings_.power_level == capped_level_(desired_.level);
+    case DesiredRun::HEAT:
+    case DesiredRun::HEAT_FAN:
+      return settings_.temperature_source == desired_.sensor && settings_.set_temperature == desired_.set_temp &&
+             settings_.wait_mode == (desired_.run == DesiredRun::HEAT ? 0x02 : 0x01);
+    default:
+      return true;
+  }
+}
+
+void AutotermUART::release_desired_state_(const char *reason) {
+  if (!desired_.active)
+    return;
+  desired_.active = false;
+  ESP_LOGD("autoterm_uart", "Sollzustand freigegeben (%s)", reason);
+}
+
+void AutotermUART::reconcile_desired_state_() {
+  if (!desired_.active || thermostat_active_ || !snapshot_.status_valid)
+    return;
+  uint32_t now = millis();
+  if ((now - reconcile_last_action_millis_) < reconcile_settle_ms_)
+    return;
+
+  // Nur eindeutige Abweichungen korrigieren; Zünd-, Abkühl- und Nachlaufphasen gelten als Übergang
+  uint16_t status = snapshot_.status_code;
+  bool start = false;
+  const char *divergence = nullptr;
+  switch (desired_.run) {
+    case DesiredRun::OFF:
+      if (is_heating_status_(status) || is_fan_status_(status))
+        divergence = "läuft noch";
+      break;
+    case DesiredRun::FAN:
+      if (status == 0x0001)
+        divergence = "steht";
+      break;
+    default:
+      if (status == 0x0001) {
+        divergence = "steht";
+        start = true;
+      } else if (status == 0x0300 && !heater_matches_desired_()) {
+        // Nur im stabilen Betrieb nachsenden; Zündung und Abkühlen sind kein Grund für ein erneutes 0x02
+        divergence = "Einstellungen weichen ab";
+      }
+      break;
+  }
+  // Nach Fehlzündung oder Fehlercode nicht selbstständig neu starten; das Fehlerbyte allein ist nicht verifiziert
+  if (divergence != nullptr && status == 0x0001 && (ignition_failed_latched_ || snapshot_.fault_code != 0))
+    divergence = nullptr;
+#ifdef USE_AUTOTERM_BATTERY_GOVERNOR
+  if (start && battery_blocks_ignition_())
+    divergence = nullptr;
+#endif
+
+  if (divergence == nullptr) {
+    if (reconcile_attempts_ > 0)
+      ESP_LOGI("autoterm_uart", "Sollzustand erreicht nach %u Korrektur(en)", reconcile_attempts_);
+    reconcile_attempts_ = 0;
+    reconcile_gave_up_ = false;
+    return;
+  }
+  if (reconcile_attempts_ >= reconcile_max_retries_) {
+    if (!reconcile_gave_up_) {
+      reconcile_gave_up_ = true;
+      ESP_LOGE("autoterm_uart", "Heizung %s, Sollzustand nach %u Korrekturen nicht erreicht", divergence,
+               reconcile_attempts_);
+    }
+    return;
+  }
+
+  reconcile_attempts_++;
+  reconcile_corrections_++;
+  reconcile_last_action_millis_ = now;
+  ESP_LOGW("autoterm_uart", "Heizung %s, Korrektur %u/%u", divergence, reconcile_attempts_, reconcile_max_retries_);
+  reconcile_resend_ = true;
+  switch (desired_.run) {
+    case DesiredRun::OFF:
+      send_standby();
+      break;
+    case DesiredRun::FAN:
+      send_fan_only(desired_.level);
+      break;
+    case DesiredRun::POWER:
+      send_power_mode(start, desired_.level);
+      break;
+    case DesiredRun::HEAT:
+    case DesiredRun::HEAT_FAN: {
+      const uint8_t payload[] = {0xFF, 0xFF, desired_.sensor, desired_.set_temp,
+                                 static_cast<uint8_t>(desired_.run == DesiredRun::HEAT ? 0x02 : 0x01), 0xFF};
+      send_command_(start ? 0x01 : 0x02, payload, sizeof(payload), "reconcile.heizen");
+      break;
+    }
+  }
+  reconcile_resend_ = false;
+}
+#endif
+
+#ifdef USE_AUTOTERM_BATTERY_GOVERNOR
+void AutotermUART::update_battery_governor_(float voltage) {
+  if (!std::isfinite(voltage) || voltage < 1.0f)
+    return;
+  // Die Glühkerze zieht in der Zündphase den höchsten Strom; dieser Einbruch geht nicht in Filter und Trend ein
+  if (is_ignition_status_(snapshot_.status_code))
+    return;
+  uint32_t now = millis();
+  if (std::isnan(battery_filtered_v_)) {
+    battery_filtered_v_ = voltage;
+    battery_trend_vph_ = 0.0f;
+  } else {
+    uint32_t dt_ms = now - battery_last_sample_millis_;
+    if (dt_ms == 0)
+      return;
+    // Exponentielle Glättung mit Zeitkonstante, unabhängig vom Frame-Abstand
+    float alpha = 1.0f - expf(-static_cast<float>(dt_ms) / battery_filter_ms_);
+    float previous = battery_filtered_v_;
+    battery_filtered_v_ += alpha * (voltage - battery_filtered_v_);
+    float slope_vph = (battery_filtered_v_ - previous) * 3600000.0f / dt_ms;
+    float trend_alpha = 1.0f - expf(-static_cast<float>(dt_ms) / battery_trend_ms_);
+    battery_trend_vph_ += trend_alpha * (slope_vph - battery_trend_vph_);
+  }
+  battery_last_sample_millis_ = now;
+
+  // Nur ein fallender Trend verschärft die Prognose; gelockert wird erst über resume_above
+  float projected = battery_filtered_v_ + std::min(battery_trend_vph_, 0.0f) * battery_lookahead_ms_ / 3600000.0f;
+  BatteryGovernorState target = BatteryGovernorState::NORMAL;
+  if (projected < battery_stop_below_v_)
+    target = BatteryGovernorState::SHUTDOWN;
+  else if (projected < battery_block_below_v_)
+    target = BatteryGovernorState::IGNITION_BLOCKED;
+  else if (projected < battery_reduce_below_v_)
+    target = BatteryGovernorState::REDUCED;
+  if (target > battery_state_) {
+    set_battery_state_(target);
+  } else if (battery_state_ != BatteryGovernorState::NORMAL && target == BatteryGovernorState::NORMAL &&
+             battery_filtered_v_ >= battery_resume_above_v_) {
+    set_battery_state_(BatteryGovernorState::NORMAL);
+  }
+
+  // Solange die Prognose unter reduce_below liegt, je step_interval eine Stufe tiefer
+  if (battery_state_ != BatteryGovernorState::NORMAL && heater_running_ && projected < battery_reduce_below_v_ &&
+      (now - battery_last_step_millis_) >= battery_step_interval_ms_) {
+    uint8_t current = battery_level_cap_;
+    if (settings_valid_ && settings_.temperature_source == 0x04)
+      current = std::min(current, settings_.power_level);
+    if (current > battery_min_level_) {
+      battery_level_cap_ = current - 1;
+      battery_last_step_millis_ = now;
+      ESP_LOGW("autoterm_uart", "Batterie %.2f V (Trend %+.2f V/h, Prognose %.2f V): Stufe höchstens %u",
+               battery_filtered_v_, battery_trend_vph_, projected, battery_level_cap_);
+      battery_publish_pending_ = true;
+    }
+  }
+  enforce_battery_level_cap_();
+  // Zustandswechsel und erste Stufe als ein Ereignis
+  if (battery_publish_pending_) {
+    battery_publish_pending_ = false;
+    publish_battery_state_();
+  }
+
+  if (battery_filtered_sensor_ != nullptr && !(fabsf(battery_filtered_v_ - battery_filtered_published_) < 0.01f)) {
+    battery_filtered_published_ = battery_filtered_v_;
+    battery_filtered_sensor_->publish_state(battery_filtered_v_);
+  }
+  if (battery_trend_sensor_ != nullptr && !(fabsf(battery_trend_vph_ - battery_trend_published_) < 0.01f)) {
+    battery_trend_published_ = battery_trend_vph_;
+    battery_trend_sensor_->publish_state(battery_trend_vph_);
+  }
+}
+
+void AutotermUART::set_battery_state_(BatteryGovernorState state) {
+  BatteryGovernorState previous = battery_state_;
+  battery_state_ = state;
+  battery_block_logged_ = false;
+  uint32_t now = millis();
+  if (state == BatteryGovernorState::NORMAL) {
+    battery_level_cap_ = 9;
+    ESP_LOGI("autoterm_uart", "Batterie erholt (%.2f V), keine Einschränkung mehr", battery_filtered_v_);
+  } else {
+    if (previous == BatteryGovernorState::NORMAL)
+      battery_last_step_millis_ = now - battery_step_interval_ms_;  // erste Stufe sofort
+    ESP_LOGW("autoterm_uart", "Batterie %.2f V (Trend %+.2f V/h): %s", battery_filtered_v_, battery_trend_vph_,
+             battery_governor_state_text(state));
+  }
+  // Sauber abschalten, bevor die Heizung mit Unterspannung mitten im Zyklus abbricht
+  if (state == BatteryGovernorState::SHUTDOWN && (heater_running_ || is_fan_status_(snapshot_.status_code)))
+    send_standby();
+  battery_publish_pending_ = true;
+}
+
+void AutotermUART::publish_battery_state_() {
+  char text[48];
+  if (battery_level_cap_ < 9 && battery_state_ != BatteryGovernorState::SHUTDOWN) {
+    snprintf(text, sizeof(text), "%s (max. Stufe %u)", battery_governor_state_text(battery_state_),
+             battery_level_cap_);
+  } else {
+    snprintf(text, sizeof(text), "%s", battery_governor_state_text(battery_state_));
+  }
+  if (battery_state_sensor_ != nullptr)
+    battery_state_sensor_->publish_state(text);
+  battery_governor_callback_.call(text, battery_filtered_v_);
+}
+
+void AutotermUART::enforce_battery_level_cap_() {
+  // Nur im Leistungsmodus steht die Stufe fest; im Temperaturbetrieb regelt die Heizung selbst
+  if (!heater_running_ || !settings_valid_ || settings_.temperature_source != 0x04 ||
+      settings_.power_level <= battery_level_cap_)
+    return;
+  uint32_t now = millis();
+  if (battery_last_enforce_millis_ != 0 && (now - battery_last_enforce_millis_) < 10000)
+    return;
+  battery_last_enforce_millis_ = now;
+  const uint8_t payload[] = {0xFF, 0xFF, 0x04, 0xFF, 0x02, battery_level_cap_};
+  send_command_(0x02, payload, sizeof(payload), "battery.stufe");
+}
+
+bool AutotermUART::apply_battery_governor_(uint8_t command, uint8_t *payload, size_t length) {
+  if (command == 0x01 && battery_blocks_ignition_()) {
+    battery_blocked_starts_++;
+    if (!battery_block_logged_) {
+      battery_block_logged_ = true;
+      ESP_LOGW("autoterm_uart", "Batterie %.2f V, %s: Start der Bridge verworfen", battery_filtered_v_,
+               battery_governor_state_text(battery_state_));
+    }
+    // Abgelehnter Start bleibt abgelehnt, auch nach der Erholung
+    release_desired_state_("Batterie");
+    return false;
+  }
+  if ((command == 0x01 || command == 0x02) && length == 6 && payload[5] != 0xFF && payload[5] > battery_level_cap_) {
+    ESP_LOGD("autoterm_uart", "Batterie: Stufe %u -> %u (Bridge)", payload[5], battery_level_cap_);
+    payload[5] = battery_level_cap_;
+  }
+  return true;
+}
+
+void AutotermUART::note_panel_blocked_starts_() {
+  uint32_t blocked = battery_panel_blocked_.load(std::memory_order_relaxed);
+  if (blocked == battery_panel_blocked_seen_)
+    return;
+  battery_blocked_starts_ += blocked - battery_panel_blocked_seen_;
+  battery_panel_blocked_seen_ = blocked;
+  if (!battery_block_logged_) {
+    battery_block_logged_ = true;
+    ESP_LOGW("autoterm_uart", "Batterie %.2f V, %s: Start vom Bedienteil verworfen", battery_filtered_v_,
+             battery_governor_state_text(battery_state_));
+  }
+}
+#endif
+
+void AutotermUART::send_standby() {
+  // Sicherheitskritisch: ohne Wartefenster, und nichts Älteres darf danach noch starten
+  cancel_command_intents_();
+  record_desired_(DesiredRun::OFF, 0, 0, 0);
+  if (send_command_(0x03, nullptr, 0, "mode.standby"))
+    last_standby_millis_ = millis();
+}
 
 void AutotermUART::send_power_mode(bool start, uint8_t level) {
   uint8_t clamped_level = std::min<uint8_t>(level, 9);
-  std::vector<uint8_t> payload{0xFF, 0xFF, 0x04, 0xFF, 0x02, clamped_level};
-  send_command_(start ? 0x01 : 0x02, payload, start ? "mode.leistungsmodus.start" : "mode.leistungsmodus.set");
+  if (record_desired_(DesiredRun::POWER, clamped_level, 0x04, 0xFF))
+    return;
+  const uint8_t payload[] = {0xFF, 0xFF, 0x04, 0xFF, 0x02, clamped_level};
+  queue_command_(start ? COMMAND_CLASS_MODE : COMMAND_CLASS_SETTINGS, start ? 0x01 : 0x02, payload, sizeof(payload),
+                 start ? "mode.leistungsmodus.start" : "mode.leistungsmodus.set");
 }
 
 void AutotermUART::send_temperature_hold_mode(bool start, uint8_t temp_sensor, uint8_t set_temp) {
   uint8_t sensor = map_source_to_heater_(temp_sensor);
   uint8_t temp_byte = std::min<uint8_t>(set_temp, 30);
-  std::vector<uint8_t> payload{0xFF, 0xFF, sensor, temp_byte, 0x02, 0xFF};
-  send_command_(start ? 0x01 : 0x02, payload, start ? "mode.heizen.start" : "mode.heizen.set");
+  if (record_desired_(DesiredRun::HEAT, 0, sensor, temp_byte))
+    return;
+  const uint8_t payload[] = {0xFF, 0xFF, sensor, temp_byte, 0x02, 0xFF};
+  queue_command_(start ? COMMAND_CLASS_MODE : COMMAND_CLASS_SETTINGS, start ? 0x01 : 0x02, payload, sizeof(payload),
+                 start ? "mode.heizen.start" : "mode.heizen.set");
 }
 
 void AutotermUART::send_temperature_to_fan_mode(bool start, uint8_t temp_sensor, uint8_t set_temp) {
   uint8_t sensor = map_source_to_heater_(temp_sensor);
   uint8_t temp_byte = std::min<uint8_t>(set_temp, 30);
-  std::vector<uint8_t> payload{0xFF, 0xFF, sensor, temp_byte, 0x01, 0xFF};
-  send_command_(start ? 0x01 : 0x02, payload, start ? "mode.heizen_plus_lueften.start" : "mode.heizen_plus_lueften.set");
+  if (record_desired_(DesiredRun::HEAT_FAN, 0, sensor, temp_byte))
+    return;
+  const uint8_t payload[] = {0xFF, 0xFF, sensor, temp_byte, 0x01, 0xFF};
+  queue_command_(start ? COMMAND_CLASS_MODE : COMMAND_CLASS_SETTINGS, start ? 0x01 : 0x02, payload, sizeof(payload),
+                 start ? "mode.heizen_plus_lueften.start" : "mode.heizen_plus_lueften.set");
 }
 
 void AutotermUART::send_fan_only(uint8_t level) {
   uint8_t clamped_level = std::min<uint8_t>(level, 9);
-  std::vector<uint8_t> payload{0xFF, 0xFF, clamped_level, 0xFF};
-  send_command_(0x23, payload, "mode.fan_only");
+  record_desired_(DesiredRun::FAN, clamped_level, 0, 0);
+  const uint8_t payload[] = {0xFF, 0xFF, clamped_level, 0xFF};
+  queue_command_(COMMAND_CLASS_MODE, 0x23, payload, sizeof(payload), "mode.fan_only");
 }
 
+#ifdef USE_AUTOTERM_THERMOSTAT
 void AutotermUART::configure_thermostat_mode(float target_c, uint8_t level, uint8_t sensor_source,
                                              float hys_on_c, float hys_off_c) {
-  float clamped_target = clamp_thermostat_target_(target_c);
+  // Einmalige Umrechnung in 0,1 °C; die Regelung vergleicht danach nur Ganzzahlen
+  int16_t clamped_target = float_to_deci(clamp_thermostat_target_(target_c));
   uint8_t clamped_level = std::min<uint8_t>(level, 9);
   uint8_t clamped_sensor = clamp_temp_source_(sensor_source);
-  float clamped_hys_on = clamp_thermostat_hys_on_(hys_on_c);
-  float clamped_hys_off = clamp_thermostat_hys_off_(hys_off_c);
+  int16_t clamped_hys_on = float_to_deci(clamp_thermostat_hys_on_(hys_on_c));
+  int16_t clamped_hys_off = float_to_deci(clamp_thermostat_hys_off_(hys_off_c));
 
+  invalidate_decode_cache_();
+  // Das Thermostat schaltet selbst ein und aus; kein fester Sollzustand
+  release_desired_state_("Thermostat");
   bool was_active = thermostat_active_;
   bool log_needed = !was_active ||
-                    thermostat_target_c_ != clamped_target ||
+                    thermostat_target_dc_ != clamped_target ||
                     thermostat_level_ != clamped_level ||
                     thermostat_sensor_source_ != clamped_sensor ||
-                    thermostat_hys_on_c_ != clamped_hys_on ||
-                    thermostat_hys_off_c_ != clamped_hys_off;
+                    thermostat_hys_on_dc_ != clamped_hys_on ||
+                    thermostat_hys_off_dc_ != clamped_hys_off;
 
   thermostat_active_ = true;
-  thermostat_target_c_ = clamped_target;
+  thermostat_target_dc_ = clamped_target;
   thermostat_level_ = clamped_level;
   thermostat_sensor_source_ = clamped_sensor;
-  thermostat_hys_on_c_ = clamped_hys_on;
-  thermostat_hys_off_c_ = clamped_hys_off;
+  thermostat_hys_on_dc_ = clamped_hys_on;
+  thermostat_hys_off_dc_ = clamped_hys_off;
 
   if (thermostat_last_sent_level_ == 255)
     thermostat_last_sent_level_ = thermostat_level_;
@@ -1063,9 +3343,9 @@ void AutotermUART::configure_thermostat_mode(float target_c, uint8_t level, uint
   if (log_needed) {
     ESP_LOGI("autoterm_uart",
              "Thermostat config -> target=%.1f°C level=%u sensor=%u hys_on=%.1f°C hys_off=%.1f°C",
-             thermostat_target_c_, static_cast<unsigned>(thermostat_level_),
+             deci_to_float(thermostat_target_dc_), static_cast<unsigned>(thermostat_level_),
              static_cast<unsigned>(thermostat_sensor_source_),
-             thermostat_hys_on_c_, thermostat_hys_off_c_);
+             deci_to_float(thermostat_hys_on_dc_), deci_to_float(thermostat_hys_off_dc_));
   }
 
   evaluate_thermostat_control_(true);
@@ -1074,6 +3354,7 @@ void AutotermUART::configure_thermostat_mode(float target_c, uint8_t level, uint
 void AutotermUART::disable_thermostat_mode() {
   if (!thermostat_active_)
     return;
+  invalidate_decode_cache_();
 
   ESP_LOGI("autoterm_uart", "Thermostat mode deactivated");
   thermostat_active_ = false;
@@ -1090,21 +3371,24 @@ void AutotermUART::evaluate_thermostat_control_(bool force) {
   if (!force && (now - thermostat_last_evaluation_millis_) < 1000)
     return;
   thermostat_last_evaluation_millis_ = now;
+#ifdef USE_AUTOTERM_BENCHMARK
+  ProfileScope profile(call_profile_[PROFILE_THERMOSTAT]);
+#endif
 
   uint8_t effective_source = get_effective_temp_source();
   if (effective_source != thermostat_sensor_source_)
     thermostat_sensor_source_ = clamp_temp_source_(effective_source);
   uint8_t source = thermostat_sensor_source_;
 
-  float current_temp = get_temperature_for_source(source);
-  if (!std::isfinite(current_temp))
+  int16_t current_dc = get_temperature_for_source_dc(source);
+  if (current_dc == TEMP_DC_INVALID)
     return;
 
-  float on_threshold = thermostat_target_c_ - thermostat_hys_on_c_;
-  float off_threshold = thermostat_target_c_ + thermostat_hys_off_c_;
+  int16_t on_threshold = thermostat_target_dc_ - thermostat_hys_on_dc_;
+  int16_t off_threshold = thermostat_target_dc_ + thermostat_hys_off_dc_;
 
   if (!thermostat_heating_request_ && !thermostat_waiting_for_idle_) {
-    if (current_temp < on_threshold) {
+    if (current_dc < on_threshold) {
       bool command_recent = thermostat_last_command_millis_ != 0 &&
                             (now - thermostat_last_command_millis_) < 1000;
       if (command_recent)
@@ -1122,24 +3406,31 @@ void AutotermUART::evaluate_thermostat_control_(bool force) {
       thermostat_heating_request_ = true;
       ESP_LOGI("autoterm_uart",
                "Thermostat: start heating (temp=%.1f°C target=%.1f°C level=%u)",
-               current_temp, thermostat_target_c_, static_cast<unsigned>(thermostat_level_));
+               deci_to_float(current_dc), deci_to_float(thermostat_target_dc_),
+               static_cast<unsigned>(thermostat_level_));
+#ifdef USE_AUTOTERM_ON_THERMOSTAT_CYCLE
+      thermostat_cycle_callback_.call(true, deci_to_float(current_dc));
+#endif
     }
   } else if (thermostat_heating_request_) {
-    if (current_temp > off_threshold) {
+    if (current_dc > off_threshold) {
       bool command_recent = thermostat_last_command_millis_ != 0 &&
                             (now - thermostat_last_command_millis_) < 1000;
       if (command_recent)
         return;
 
-      float cooldown_target = std::max(0.0f, thermostat_target_c_ - 5.0f);
-      uint8_t temp_byte = static_cast<uint8_t>(std::round(std::min(30.0f, cooldown_target)));
+      int16_t cooldown_dc = std::min<int16_t>(300, std::max<int16_t>(0, thermostat_target_dc_ - 50));
+      uint8_t temp_byte = static_cast<uint8_t>((cooldown_dc + 5) / 10);
       send_thermostat_cooldown_(source, temp_byte);
       thermostat_heating_request_ = false;
       thermostat_waiting_for_idle_ = true;
       thermostat_last_command_millis_ = millis();
       ESP_LOGI("autoterm_uart",
                "Thermostat: cooling down (temp=%.1f°C target=%.1f°C -> temp_cmd=%u)",
-               current_temp, thermostat_target_c_, static_cast<unsigned>(temp_byte));
+               deci_to_float(current_dc), deci_to_float(thermostat_target_dc_), static_cast<unsigned>(temp_byte));
+#ifdef USE_AUTOTERM_ON_THERMOSTAT_CYCLE
+      thermostat_cycle_callback_.call(false, deci_to_float(current_dc));
+#endif
     } else if (thermostat_last_sent_level_ != thermostat_level_ &&
                (now - thermostat_last_command_millis_) > 1500) {
       send_power_mode(false, thermostat_level_);
@@ -1169,20 +3460,132 @@ void AutotermUART::handle_thermostat_status_update_(uint16_t status_code) {
     }
   }
 }
+#else
+// Ohne climate/preheat ist die Thermostat-Regelung nicht einkompiliert
+void AutotermUART::configure_thermostat_mode(float target_c, uint8_t level, uint8_t sensor_source,
+                                             float hys_on_c, float hys_off_c) {
+  ESP_LOGW("autoterm_uart", "Thermostat mode not compiled in (no climate/preheat configured)");
+}
+
+void AutotermUART::disable_thermostat_mode() {}
+#endif
+
+#ifdef USE_AUTOTERM_FAULT_HISTORY
+void AutotermUART::record_fault_(const StatusFrame &st) {
+  FaultRecord &rec = fault_history_.records[fault_history_.head];
+  rec.code = st.error_code;
+  rec.status_code = st.status_code;
+  rec.timestamp = 0;
+#ifdef USE_TIME
+  if (fault_clock_ != nullptr) {
+    ESPTime t = fault_clock_->now();
+    if (t.is_valid())
+      rec.timestamp = static_cast<uint32_t>(t.timestamp);
+  }
+#endif
+  rec.uptime_s = millis() / 1000;
+#ifdef USE_AUTOTERM_RUNTIME
+  rec.runtime_hours = runtime_hours_;
+#else
+  rec.runtime_hours = NAN;
+#endif
+  rec.heater_temp_dc = st.heater_temp_dc;
+  rec.voltage_dv = st.voltage_dv;
+
+  fault_history_.head = (fault_history_.head + 1) % FAULT_HISTORY_SIZE;
+  if (fault_history_.count < FAULT_HISTORY_SIZE)
+    fault_history_.count++;
+  fault_history_.total++;
+  // Fehler sind selten, daher sofort sichern
+  if (fault_history_storage_)
+    fault_history_pref_.save(&fault_history_);
+
+  char heater_txt[8] = "--";
+  if (rec.heater_temp_dc != TEMP_DC_INVALID)
+    snprintf(heater_txt, sizeof(heater_txt), "%d", rec.heater_temp_dc / 10);
+  ESP_LOGW("autoterm_uart", "Fehler E%02u: %s (Status 0x%04X, U=%u.%uV, Heizung %s°C)", rec.code,
+           fault_code_text(rec.code), rec.status_code, rec.voltage_dv / 10, rec.voltage_dv % 10, heater_txt);
+  publish_fault_state_();
+}
+
+void AutotermUART::publish_fault_state_() {
+  if (fault_count_sensor_ != nullptr)
+    fault_count_sensor_->publish_state(fault_history_.total);
+  if (last_fault_sensor_ == nullptr)
+    return;
+  if (fault_history_.count == 0) {
+    last_fault_sensor_->publish_state("Keine");
+    return;
+  }
+  const FaultRecord &rec = fault_history_.records[(fault_history_.head + FAULT_HISTORY_SIZE - 1) % FAULT_HISTORY_SIZE];
+  char text[64];
+  snprintf(text, sizeof(text), "E%02u %s", rec.code, fault_code_text(rec.code));
+  last_fault_sensor_->publish_state(text);
+}
 
+void AutotermUART::dump_fault_history() {
+  ESP_LOGI("autoterm_uart", "Fehlerhistorie: %u gespeichert, %u insgesamt", fault_history_.count,
+           static_cast<unsigned>(fault_history_.total));
+  // Älteste zuerst
+  for (uint8_t i = 0; i < fault_history_.count; i++) {
+    const FaultRecord &rec =
+        fault_history_.records[(fault_history_.head + FAULT_HISTORY_SIZE - fault_history_.count + i) % FAULT_HISTORY_SIZE];
+    ESP_LOGI("autoterm_uart", "  #%u E%02u %s | Zeit %u | Uptime %us | Betrieb %.1fh | U=%u.%uV | Heizung %.1f°C | 0x%04X",
+             i + 1, rec.code, fault_code_text(rec.code), static_cast<unsigned>(rec.timestamp),
+             static_cast<unsigned>(rec.uptime_s), rec.runtime_hours, rec.voltage_dv / 10, rec.voltage_dv % 10,
+             deci_to_float(rec.heater_temp_dc), rec.status_code);
+  }
+}
+
+void AutotermUART::clear_fault_history() {
+  fault_history_ = FaultHistory{};
+  if (fault_history_storage_)
+    fault_history_pref_.save(&fault_history_);
+  ESP_LOGI("autoterm_uart", "Fehlerhistorie gelöscht");
+  publish_fault_state_();
+}
+#else
+void AutotermUART::dump_fault_history() {
+  ESP_LOGW("autoterm_uart", "Fehlerhistorie nicht einkompiliert (kein fault_history konfiguriert)");
+}
+
+void AutotermUART::clear_fault_history() {}
+#endif
+
+void AutotermUART::handle_phase_change_(uint16_t status_code) {
+  uint16_t previous = last_status_code_;
+  if (status_code == previous)
+    return;
+  last_status_code_ = status_code;
+#ifdef USE_AUTOTERM_ON_PHASE_CHANGE
+  phase_change_callback_.call(status_code, previous);
+#endif
+  if (previous != 0xFFFF && is_ignition_status_(status_code) && !is_ignition_status_(previous))
+    ignitions_++;
+
+  // Zündung abgebrochen ohne Heizbetrieb und ohne vorheriges Standby-Kommando
+  if (previous != 0xFFFF && is_ignition_status_(previous) && !is_ignition_status_(status_code) &&
+      status_code != 0x0300) {
+    bool standby_requested = last_standby_millis_ != 0 && (millis() - last_standby_millis_) < 10000;
+    if (!standby_requested) {
+      ESP_LOGW("autoterm_uart", "Ignition failed: 0x%04X -> 0x%04X", previous, status_code);
+      ignition_failures_++;
+#ifdef USE_AUTOTERM_RECONCILE
+      ignition_failed_latched_ = true;
+#endif
+#ifdef USE_AUTOTERM_ON_IGNITION_FAILED
+      ignition_failed_callback_.call(status_code);
+#endif
+    }
+  }
+}
+
+#ifdef USE_AUTOTERM_THERMOSTAT
 void AutotermUART::send_thermostat_cooldown_(uint8_t source, uint8_t temp_byte) {
   uint8_t sensor = map_source_to_heater_(source);
   uint8_t clamped_temp = std::min<uint8_t>(temp_byte, 30);
-  std::vector<uint8_t> payload{0xFF, 0xFF, sensor, clamped_temp, 0x01, 0xFF};
-  send_command_(0x02, payload, "mode.thermostat.cooldown");
-}
-
-float AutotermUART::clamp_thermostat_target_(float target) const {
-  if (target < 0.0f)
-    return 0.0f;
-  if (target > 30.0f)
-    return 30.0f;
-  return target;
+  const uint8_t payload[] = {0xFF, 0xFF, sensor, clamped_temp, 0x01, 0xFF};
+  queue_command_(COMMAND_CLASS_SETTINGS, 0x02, payload, sizeof(payload), "mode.thermostat.cooldown");
 }
 
 float AutotermUART::clamp_thermostat_hys_on_(float value) const {
@@ -1200,38 +3603,515 @@ float AutotermUART::clamp_thermostat_hys_off_(float value) const {
     return 2.0f;
   return value;
 }
+#endif
+
+float AutotermUART::clamp_thermostat_target_(float target) const {
+  if (target < 0.0f)
+    return 0.0f;
+  if (target > 30.0f)
+    return 30.0f;
+  return target;
+}
 
 void AutotermUART::request_settings() {
-  if (send_command_(0x02, {}, "request.settings"))
+  if (send_command_(0x02, nullptr, 0, "request.settings"))
     last_settings_request_millis_ = millis();
 }
 
+#ifdef USE_AUTOTERM_BENCHMARK
+// Ein Panel-Zyklus aus logs_air2d_run_Thermostat.txt (Heizbetrieb): 0x11, 0x02, 0x0F je Richtung
+static const uint8_t BENCH_DISPLAY_STREAM[] = {
+    0xAA, 0x03, 0x01, 0x00, 0x11, 0x13, 0x70, 0x10,
+    0xAA, 0x03, 0x00, 0x00, 0x02, 0x9D, 0xBD,
+    0xAA, 0x03, 0x00, 0x00, 0x0F, 0x58, 0x7C,
+};
+static const uint8_t BENCH_HEATER_STREAM[] = {
+    0xAA, 0x04, 0x01, 0x00, 0x11, 0x13, 0xB0, 0xA5,
+    0xAA, 0x04, 0x06, 0x00, 0x02, 0xFF, 0xFF, 0x04, 0x14, 0x02, 0x00, 0xC4, 0x2C,
+    0xAA, 0x04, 0x13, 0x00, 0x0F, 0x03, 0x00, 0x00, 0x15, 0x7F, 0x00, 0x83, 0x01, 0xD0,
+    0x04, 0x00, 0x28, 0x28, 0x00, 0x46, 0x00, 0x46, 0x00, 0x66, 0x47, 0xC6,
+};
+static constexpr size_t BENCH_STATUS_OFFSET = 21;
+static constexpr uint32_t BENCH_FRAMES_PER_CYCLE = 6;
+
+void AutotermUART::run_benchmark(uint32_t iterations) {
+  if (rx_task_running_) {
+    // Framing teilt sich frame_scratch_ mit dem RX-Task
+    ESP_LOGW("autoterm_uart", "Benchmark nicht möglich, solange der RX-Task läuft");
+    return;
+  }
+  if (benchmark_stage_ != BENCH_OFF) {
+    ESP_LOGW("autoterm_uart", "Benchmark läuft bereits");
+    return;
+  }
+  benchmark_iterations_ = std::max<uint32_t>(1, std::min<uint32_t>(iterations, 20000));
+  benchmark_stage_done_ = 0;
+  std::fill(std::begin(benchmark_stage_us_), std::end(benchmark_stage_us_), 0);
+  benchmark_sink_ = 0;
+  benchmark_buffer_.reserve(QueuedFrame::MAX_LENGTH);
+  benchmark_status_frame_.assign(BENCH_HEATER_STREAM + BENCH_STATUS_OFFSET, std::end(BENCH_HEATER_STREAM));
+  benchmark_stage_ = BENCH_CRC;
+  ESP_LOGI("autoterm_uart", "Benchmark gestartet (%u Iterationen pro Stufe)", static_cast<unsigned>(benchmark_iterations_));
+}
+
+// Höchstens BENCH_CHUNK_BUDGET_US pro loop(), damit der Bus weiter bedient wird
+void AutotermUART::run_benchmark_chunk_() {
+  // Messläufe dürfen die echten Buszähler nicht verfälschen
+  BusCounters saved_counters = copy_bus_counters_();
+  uint32_t start = micros();
+  uint32_t elapsed = 0;
+  while (benchmark_stage_done_ < benchmark_iterations_ && elapsed < BENCH_CHUNK_BUDGET_US) {
+    uint32_t count = std::min<uint32_t>(16, benchmark_iterations_ - benchmark_stage_done_);
+    run_benchmark_batch_(count);
+    benchmark_stage_done_ += count;
+    elapsed = micros() - start;
+  }
+  benchmark_stage_us_[benchmark_stage_ - BENCH_CRC] += elapsed;
+  restore_bus_counters_(saved_counters);
+
+  if (benchmark_stage_done_ < benchmark_iterations_)
+    return;
+  benchmark_stage_done_ = 0;
+  benchmark_stage_ = static_cast<BenchmarkStage>(benchmark_stage_ + 1);
+  if (benchmark_stage_ == BENCH_DONE) {
+    report_benchmark_();
+    benchmark_stage_ = BENCH_OFF;
+  }
+}
+
+void AutotermUART::run_benchmark_batch_(uint32_t count) {
+  const uint8_t *streams[2] = {BENCH_DISPLAY_STREAM, BENCH_HEATER_STREAM};
+  const size_t stream_lengths[2] = {sizeof(BENCH_DISPLAY_STREAM), sizeof(BENCH_HEATER_STREAM)};
+  StatusFrame st;
+  for (uint32_t i = 0; i < count; i++) {
+    switch (benchmark_stage_) {
+      case BENCH_CRC:
+        benchmark_sink_ += crc16_modbus_(benchmark_status_frame_.data(), benchmark_status_frame_.size() - 2);
+        break;
+      case BENCH_DECODE:
+        decode_status_(benchmark_status_frame_, st);
+        benchmark_sink_ += st.heater_temp_dc;
+        break;
+      case BENCH_FRAMING:
+      case BENCH_REPLAY:
+        for (uint8_t direction = 0; direction < 2; direction++) {
+          for (size_t b = 0; b < stream_lengths[direction]; b++) {
+            benchmark_buffer_.push_back(streams[direction][b]);
+            extract_frames_(benchmark_buffer_, nullptr, "bench", direction);
+          }
+        }
+        break;
+      default:
+        return;
+    }
+  }
+}
+
+// Verzweigt wie handle_frame_, ruft aber nur die reinen Dekoder auf
+void AutotermUART::replay_benchmark_frame_(const std::vector<uint8_t> &frame, bool from_display) {
+  if (is_panel_temperature_frame_(frame)) {
+    benchmark_sink_ += frame[5];
+    return;
+  }
+  StatusFrame st;
+  Settings settings;
+  if (!from_display && decode_status_(frame, st))
+    benchmark_sink_ += st.status_code + st.heater_temp_dc;
+  else if (!from_display && decode_settings_(frame, settings))
+    benchmark_sink_ += settings.power_level;
+  else
+    benchmark_sink_ += frame[4];
+}
+
+void AutotermUART::report_benchmark_() {
+  uint32_t iterations = benchmark_iterations_;
+  uint64_t bytes = static_cast<uint64_t>(iterations) * (sizeof(BENCH_DISPLAY_STREAM) + sizeof(BENCH_HEATER_STREAM));
+  uint64_t frames = static_cast<uint64_t>(iterations) * BENCH_FRAMES_PER_CYCLE;
+  uint32_t replay_us = benchmark_stage_us_[BENCH_REPLAY - BENCH_CRC];
+  char profiles[256];
+  size_t pos = 0;
+  static const char *const PROFILE_NAMES[PROFILE_COUNT] = {"parse_status", "parse_settings", "thermostat"};
+  for (uint8_t i = 0; i < PROFILE_COUNT; i++) {
+    const CallProfile &p = call_profile_[i];
+    pos += snprintf(profiles + pos, sizeof(profiles) - pos, ",\"%s\":{\"n\":%u,\"ns\":%u}",
+                    PROFILE_NAMES[i], static_cast<unsigned>(p.calls),
+                    static_cast<unsigned>(p.calls == 0 ? 0 : static_cast<uint64_t>(p.total_us) * 1000 / p.calls));
+    if (pos >= sizeof(profiles))
+      break;
+  }
+  std::fill(std::begin(call_profile_), std::end(call_profile_), CallProfile{});
+
+  ESP_LOGI("autoterm_uart",
+           "BENCH {\"version\":3,\"iterations\":%u,\"crc_ns_per_frame\":%u,\"decode_ns_per_frame\":%u,"
+           "\"framing_ns_per_byte\":%u,\"replay_ns_per_frame\":%u,\"replay_frames_per_s\":%u"
+           "%s,\"sink\":%u}",
+           static_cast<unsigned>(iterations),
+           static_cast<unsigned>(static_cast<uint64_t>(benchmark_stage_us_[0]) * 1000 / iterations),
+           static_cast<unsigned>(static_cast<uint64_t>(benchmark_stage_us_[1]) * 1000 / iterations),
+           static_cast<unsigned>(static_cast<uint64_t>(benchmark_stage_us_[2]) * 1000 / bytes),
+           static_cast<unsigned>(static_cast<uint64_t>(replay_us) * 1000 / frames),
+           static_cast<unsigned>(replay_us == 0 ? 0 : frames * 1000000ULL / replay_us),
+           profiles,
+           static_cast<unsigned>(benchmark_sink_));
+}
+#endif
+
+#ifdef USE_AUTOTERM_HEATER_MODEL
+void AutotermUART::send_model_query_() {
+  if (model_query_attempts_ >= MODEL_QUERY_ATTEMPTS) {
+    model_query_done_ = true;
+    ESP_LOGW("autoterm_uart", "Keine Antwort auf Versionsabfrage");
+    return;
+  }
+  model_query_attempts_++;
+  model_query_millis_ = millis();
+  send_command_(0x06, nullptr, 0, "request.version");
+}
+
+void AutotermUART::handle_version_frame_(const std::vector<uint8_t> &frame) {
+  uint8_t length = frame[2];
+  if (model_query_done_ || length < 4)
+    return;
+  const uint8_t *p = &frame[5];
+  snprintf(firmware_version_, sizeof(firmware_version_), "%u.%u.%u.%u", p[0], p[1], p[2], p[3]);
+  heater_model_id_ = length > 4 ? p[4] : 0xFF;
+  model_query_done_ = true;
+  ESP_LOGI("autoterm_uart", "Heizung meldet Firmware %s (Kennung 0x%02X)", firmware_version_, heater_model_id_);
+  publish_heater_model_();
+}
+
+void AutotermUART::publish_heater_model_() {
+  if (heater_model_sensor_ == nullptr)
+    return;
+  if (firmware_version_[0] == '\0') {
+    heater_model_sensor_->publish_state("Unbekannt");
+    return;
+  }
+  char text[48];
+  snprintf(text, sizeof(text), "FW %s, Kennung 0x%02X", firmware_version_, heater_model_id_);
+  heater_model_sensor_->publish_state(text);
+}
+#endif
+
 void AutotermUART::send_status_request() {
-  if (send_command_(0x0F, {}, "request.status"))
+  if (send_command_(0x0F, nullptr, 0, "request.status"))
     last_status_request_millis_ = millis();
 }
 
+#ifdef USE_AUTOTERM_PANEL_EMULATION
+void AutotermUART::note_display_panel_frame_(uint8_t command, uint32_t now) {
+  uint8_t index = 0;
+  while (index < PANEL_CYCLE_LENGTH && PANEL_CYCLE[index] != command)
+    index++;
+  // Start/Standby usw. gehören nicht zum Zyklus und verschieben die Phase nicht
+  if (index == PANEL_CYCLE_LENGTH)
+    return;
+
+  panel_cycle_index_ = (index + 1) % PANEL_CYCLE_LENGTH;
+  panel_next_slot_millis_ = now + panel_slot_ms_;
+  if (panel_emulation_active_) {
+    panel_emulation_active_ = false;
+    ESP_LOGI("autoterm_uart", "Display sendet wieder (0x%02X), Panel-Emulation beendet", command);
+  }
+}
+
+void AutotermUART::run_panel_emulation_(uint32_t now) {
+  int32_t late = static_cast<int32_t>(now - panel_next_slot_millis_);
+  if (late < 0)
+    return;
+
+  if (!panel_emulation_active_) {
+    // Übernahme, sobald der erwartete Display-Frame einen halben Slot überfällig ist
+    if (late < static_cast<int32_t>(panel_slot_ms_ / 2))
+      return;
+    panel_emulation_active_ = true;
+    panel_takeovers_++;
+    panel_last_switchover_ms_ = static_cast<uint32_t>(late);
+    ESP_LOGW("autoterm_uart", "Kein Display-Frame im Slot, Panel-Emulation übernimmt ab 0x%02X (+%u ms)",
+             PANEL_CYCLE[panel_cycle_index_], static_cast<unsigned>(late));
+    if (panel_switchover_sensor_ != nullptr)
+      panel_switchover_sensor_->publish_state(panel_last_switchover_ms_);
+    if (panel_takeover_sensor_ != nullptr)
+      panel_takeover_sensor_->publish_state(panel_takeovers_);
+  }
+
+  uint8_t command = PANEL_CYCLE[panel_cycle_index_];
+#ifdef USE_AUTOTERM_PANEL_OVERRIDE
+  // Geänderter Override-Wert geht im nächsten Slot raus; der verdrängte Frame folgt im Slot danach
+  if (panel_temp_override_pending_ && command != 0x11 && should_override_panel_temperature_() &&
+      std::isfinite(panel_temp_override_value_c_)) {
+    send_panel_slot_(0x11, now);
+  } else
+#endif
+  {
+    send_panel_slot_(command, now);
+    panel_cycle_index_ = (panel_cycle_index_ + 1) % PANEL_CYCLE_LENGTH;
+  }
+  panel_next_slot_millis_ += panel_slot_ms_;
+  // Nach einem Loop-Hänger nicht nachholen, sondern ab jetzt neu takten
+  if (static_cast<int32_t>(now - panel_next_slot_millis_) >= 0)
+    panel_next_slot_millis_ = now + panel_slot_ms_;
+}
+
+void AutotermUART::send_panel_slot_(uint8_t command, uint32_t now) {
+  switch (command) {
+    case 0x11:
+#ifdef USE_AUTOTERM_PANEL_OVERRIDE
+      if (should_override_panel_temperature_() && std::isfinite(panel_temp_override_value_c_)) {
+        send_panel_temperature_override_frame_();
+        last_panel_temp_send_millis_ = now;
+      }
+#endif
+      // Ohne Override-Quelle bleibt der Slot leer; eine erfundene Panel-Temperatur wäre schlechter als keine
+      break;
+    case 0x02:
+      request_settings();
+      break;
+    default:
+      send_status_request();
+      break;
+  }
+}
+#endif
+
+#ifdef USE_AUTOTERM_PANEL_OVERRIDE
 void AutotermUART::send_panel_temperature_override_frame_() {
   if (!uart_heater_)
     return;
   if (!std::isfinite(panel_temp_override_value_c_))
     return;
 
-  uint8_t temp_byte = compute_override_temperature_byte_();
+  uint8_t temp_byte = panel_temp_override_byte_;
 
-  std::vector<uint8_t> frame{0xAA, 0x03, 0x01, 0x00, 0x11, temp_byte};
-  append_crc_(frame);
+  uint8_t frame[8] = {0xAA, 0x03, 0x01, 0x00, 0x11, temp_byte};
+  append_crc_(frame, 6);
 
-  uart_heater_->write_array(frame);
-  uart_heater_->flush();
+  write_heater_frame_(frame, sizeof(frame));
+  panel_temp_override_sent_c_ = panel_temp_override_value_c_;
+  panel_temp_override_pending_ = false;
 
-  panel_temp_last_value_c_ = panel_temp_override_value_c_;
+  panel_temp_last_dc_ = panel_temp_override_dc_;
   if (panel_temp_sensor_ != nullptr)
     panel_temp_sensor_->publish_state(panel_temp_override_value_c_);
 
   ESP_LOGD("autoterm_uart", "Panel temperature override frame sent: byte=%u (%.1f°C)",
            static_cast<unsigned>(temp_byte), panel_temp_override_value_c_);
 }
+#endif
+
+#ifdef USE_AUTOTERM_PREHEAT
+// ===================
+// Vorheizen bis Uhrzeit
+// ===================
+void AutotermUART::schedule_preheat(uint8_t hour, uint8_t minute, float target_c) {
+  preheat_hour_ = std::min<uint8_t>(hour, 23);
+  preheat_minute_ = std::min<uint8_t>(minute, 59);
+  preheat_target_c_ = std::isfinite(target_c) ? clamp_thermostat_target_(target_c) : preheat_default_target_c_;
+  preheat_deadline_ts_ = 0;
+  preheat_scheduled_ = true;
+  preheat_published_start_min_ = -1;
+  ESP_LOGI("autoterm_uart", "Preheat scheduled: %.1f°C at %02u:%02u", preheat_target_c_,
+           static_cast<unsigned>(preheat_hour_), static_cast<unsigned>(preheat_minute_));
+  evaluate_preheat_();
+}
+
+void AutotermUART::cancel_preheat() {
+  if (!preheat_scheduled_)
+    return;
+  preheat_scheduled_ = false;
+  preheat_deadline_ts_ = 0;
+  ESP_LOGI("autoterm_uart", "Preheat cancelled");
+  publish_preheat_status_();
+}
+
+void AutotermUART::evaluate_preheat_() {
+  preheat_last_evaluation_millis_ = millis();
+  if (!preheat_scheduled_)
+    return;
+#ifdef USE_TIME
+  if (preheat_clock_ == nullptr) {
+    ESP_LOGW("autoterm_uart", "Preheat requested without time source, ignoring");
+    preheat_scheduled_ = false;
+    publish_preheat_status_();
+    return;
+  }
+  ESPTime now = preheat_clock_->now();
+  if (!now.is_valid())
+    return;
+
+  int32_t now_sod = now.hour * 3600 + now.minute * 60 + now.second;
+  int32_t deadline_sod = preheat_hour_ * 3600 + preheat_minute_ * 60;
+  if (preheat_deadline_ts_ == 0) {
+    int32_t until = deadline_sod - now_sod;
+    if (until <= 0)
+      until += 86400;
+    preheat_deadline_ts_ = static_cast<int64_t>(now.timestamp) + until;
+  }
+  int64_t remaining_s = preheat_deadline_ts_ - static_cast<int64_t>(now.timestamp);
+
+  float current = get_temperature_for_source(get_effective_temp_source());
+  float needed_s = 0.0f;
+  if (std::isfinite(current) && current < preheat_target_c_) {
+    float rate = warmup_rate_for_(preheat_level_, deci_to_float(last_external_temp_dc_));
+    needed_s = static_cast<float>(preheat_startup_s_) + (preheat_target_c_ - current) / rate * 60.0f * 1.1f;
+    needed_s = std::min(needed_s, static_cast<float>(preheat_max_lead_s_));
+  } else if (!std::isfinite(current)) {
+    needed_s = static_cast<float>(preheat_max_lead_s_);
+  }
+
+  if (remaining_s <= 0) {
+    // Zeitpunkt erreicht: noch kalt → trotzdem starten, sonst nur abschließen
+    if (needed_s > 0.0f)
+      start_preheat_();
+    preheat_scheduled_ = false;
+    publish_preheat_status_();
+    return;
+  }
+
+  if (static_cast<float>(remaining_s) <= needed_s) {
+    ESP_LOGI("autoterm_uart", "Preheat start: temp=%.1f°C target=%.1f°C need=%.0fs remaining=%llds", current,
+             preheat_target_c_, needed_s, static_cast<long long>(remaining_s));
+    start_preheat_();
+    preheat_scheduled_ = false;
+    publish_preheat_status_();
+    return;
+  }
+
+  int32_t start_sod = deadline_sod - static_cast<int32_t>(needed_s);
+  if (start_sod < 0)
+    start_sod += 86400;
+  publish_preheat_status_(start_sod / 60);
+#else
+  ESP_LOGW("autoterm_uart", "Preheat requested without time component, ignoring");
+  preheat_scheduled_ = false;
+  publish_preheat_status_();
+#endif
+}
+
+void AutotermUART::start_preheat_() {
+  if (climate_ != nullptr) {
+    LabelLanguage language = climate_->get_label_language();
+    auto call = climate_->make_call();
+    call.set_mode(climate::CLIMATE_MODE_HEAT);
+    call.set_preset(heater_mode_label(HeaterMode::THERMOSTAT, language));
+    call.set_fan_mode(fan_level_label(preheat_level_, language));
+    call.set_target_temperature(preheat_target_c_);
+    call.perform();
+    return;
+  }
+#ifdef USE_AUTOTERM_THERMOSTAT
+  configure_thermostat_mode(preheat_target_c_, preheat_level_, get_effective_temp_source(),
+                            deci_to_float(thermostat_hys_on_dc_), deci_to_float(thermostat_hys_off_dc_));
+#endif
+}
+
+void AutotermUART::publish_preheat_status_(int32_t start_minute_of_day) {
+  if (preheat_status_sensor_ == nullptr)
+    return;
+  if (preheat_scheduled_ && start_minute_of_day == preheat_published_start_min_)
+    return;
+  preheat_published_start_min_ = start_minute_of_day;
+
+  char buf[64];
+  if (!preheat_scheduled_) {
+    snprintf(buf, sizeof(buf), "Inaktiv");
+  } else if (start_minute_of_day < 0) {
+    snprintf(buf, sizeof(buf), "Geplant: %.0f°C um %02u:%02u", preheat_target_c_,
+             static_cast<unsigned>(preheat_hour_), static_cast<unsigned>(preheat_minute_));
+  } else {
+    snprintf(buf, sizeof(buf), "Start %02d:%02d für %.0f°C um %02u:%02u", start_minute_of_day / 60,
+             start_minute_of_day % 60, preheat_target_c_, static_cast<unsigned>(preheat_hour_),
+             static_cast<unsigned>(preheat_minute_));
+  }
+  preheat_status_sensor_->publish_state(buf);
+}
+
+float AutotermUART::warmup_rate_for_(uint8_t level, float outside_c) const {
+  uint8_t lvl = std::min<uint8_t>(level, WARMUP_LEVELS - 1);
+  uint8_t bin = warmup_outside_bin_(outside_c);
+  // Gelernte Werte nur mit Stichproben und Rate > 0,01 °C/min, sonst explodiert die Vorlaufzeit
+  auto usable = [this, bin](uint8_t l) {
+    return warmup_model_.samples[l][bin] > 0 && warmup_model_.rate_c_per_min[l][bin] > 0.01f;
+  };
+  if (usable(lvl))
+    return warmup_model_.rate_c_per_min[lvl][bin];
+  // Nachbarstufen derselben Außentemperatur als Schätzung heranziehen
+  for (uint8_t d = 1; d < WARMUP_LEVELS; d++) {
+    if (lvl >= d && usable(lvl - d))
+      return warmup_model_.rate_c_per_min[lvl - d][bin];
+    if (lvl + d < WARMUP_LEVELS && usable(lvl + d))
+      return warmup_model_.rate_c_per_min[lvl + d][bin];
+  }
+  return std::max(preheat_default_rate_c_per_min_, 0.01f);
+}
+
+uint8_t AutotermUART::warmup_outside_bin_(float outside_c) {
+  // 127 °C meldet die Heizung ohne angeschlossenen Außenfühler
+  if (!std::isfinite(outside_c) || outside_c > 60.0f)
+    return 2;
+  if (outside_c < -10.0f)
+    return 0;
+  if (outside_c < 0.0f)
+    return 1;
+  if (outside_c < 10.0f)
+    return 2;
+  return 3;
+}
+
+void AutotermUART::update_warmup_learning_(uint16_t status_code) {
+  uint8_t level = 255;
+  if (settings_valid_ && settings_.temperature_source == 0x04)
+    level = std::min<uint8_t>(settings_.power_level, WARMUP_LEVELS - 1);
+#ifdef USE_AUTOTERM_THERMOSTAT
+  if (thermostat_active_)
+    level = thermostat_level_;
+#endif
+
+  float temp = get_temperature_for_source(get_effective_temp_source());
+  uint32_t now = millis();
+  if (status_code != 0x0300 || level == 255 || !std::isfinite(temp)) {
+    warmup_sample_active_ = false;
+    return;
+  }
+
+  uint8_t bin = warmup_outside_bin_(deci_to_float(last_external_temp_dc_));
+  if (!warmup_sample_active_ || warmup_sample_level_ != level || warmup_sample_bin_ != bin) {
+    warmup_sample_active_ = true;
+    warmup_sample_level_ = level;
+    warmup_sample_bin_ = bin;
+    warmup_sample_start_c_ = temp;
+    warmup_sample_start_millis_ = now;
+    return;
+  }
+
+  uint32_t elapsed = now - warmup_sample_start_millis_;
+  if (elapsed < 300000)
+    return;
+
+  float minutes = static_cast<float>(elapsed) / 60000.0f;
+  float rate = (temp - warmup_sample_start_c_) / minutes;
+  warmup_sample_start_c_ = temp;
+  warmup_sample_start_millis_ = now;
+  if (rate < 0.01f || rate > 5.0f)
+    return;
+
+  float &stored = warmup_model_.rate_c_per_min[level][bin];
+  uint8_t &samples = warmup_model_.samples[level][bin];
+  stored = samples == 0 ? rate : stored * 0.7f + rate * 0.3f;
+  if (samples < 255)
+    samples++;
+  warmup_model_dirty_ = true;
+  ESP_LOGD("autoterm_uart", "Aufheizrate Stufe %u Bereich %u: %.3f°C/min (Messung %.3f)",
+           static_cast<unsigned>(level), static_cast<unsigned>(bin), stored, rate);
+}
+
+void AutotermUART::save_warmup_model_() {
+  if (!warmup_model_dirty_ || global_preferences == nullptr)
+    return;
+  if (warmup_model_pref_.save(&warmup_model_))
+    warmup_model_dirty_ = false;
+}
+#endif
 
 // ===================
 // AutotermClimate Implementierungen
@@ -1239,21 +4119,14 @@ void AutotermUART::send_panel_temperature_override_frame_() {
 
 void AutotermClimate::set_parent(AutotermUART *parent) {
   parent_ = parent;
-  preset_mode_ = sanitize_preset_(preset_mode_);
   this->mode = climate::CLIMATE_MODE_OFF;
   this->action = climate::CLIMATE_ACTION_OFF;
   this->fan_mode.reset();
   fan_level_ = clamp_level_(fan_level_);
-  {
-    std::string fan_label = fan_mode_label_from_level_(fan_level_);
-    if (!fan_label.empty())
-      this->custom_fan_mode = fan_label;
-    else
-      this->custom_fan_mode.reset();
-  }
+  assign_label_(this->custom_fan_mode, fan_level_label(fan_level_, label_language_));
   this->preset.reset();
-  if (!preset_mode_.empty())
-    this->custom_preset = preset_mode_;
+  if (heater_mode_ != HeaterMode::NONE)
+    assign_label_(this->custom_preset, heater_mode_label(heater_mode_, label_language_));
   else
     this->custom_preset.reset();
   target_temperature_c_ = clamp_temperature_(target_temperature_c_);
@@ -1267,11 +4140,16 @@ void AutotermClimate::set_parent(AutotermUART *parent) {
 void AutotermClimate::set_default_level(uint8_t level) {
   fan_level_ = clamp_level_(level);
   this->fan_mode.reset();
-  std::string fan_label = fan_mode_label_from_level_(fan_level_);
-  if (!fan_label.empty())
-    this->custom_fan_mode = fan_label;
-  else
-    this->custom_fan_mode.reset();
+  assign_label_(this->custom_fan_mode, fan_level_label(fan_level_, label_language_));
+}
+
+void AutotermClimate::set_label_language(LabelLanguage language) {
+  if (language == label_language_)
+    return;
+  label_language_ = language;
+  traits_built_ = false;
+  traits_cache_ = climate::ClimateTraits();
+  mark_dirty_(publish_labels_());
 }
 
 void AutotermClimate::set_default_temperature(float temperature_c) {
@@ -1295,28 +4173,28 @@ void AutotermClimate::set_thermostat_hysteresis(float hys_on_c, float hys_off_c)
 }
 
 climate::ClimateTraits AutotermClimate::traits() {
-  climate::ClimateTraits traits;
-  traits.set_supported_modes({
+  if (!traits_built_)
+    build_traits_();
+  return traits_cache_;
+}
+
+void AutotermClimate::build_traits_() {
+  traits_cache_.set_supported_modes({
       climate::CLIMATE_MODE_OFF,
       climate::CLIMATE_MODE_HEAT,
       climate::CLIMATE_MODE_FAN_ONLY,
       climate::CLIMATE_MODE_AUTO,
   });
-  std::set<std::string> presets;
-  presets.insert("Leistungsmodus");
-  presets.insert("Heizen");
-  presets.insert("Heizen+Lüften");
-  presets.insert("Thermostat");
-  traits.set_supported_custom_presets(std::move(presets));
-  std::set<std::string> fan_modes;
-  for (int i = 0; i <= 9; i++)
-    fan_modes.insert("Stufe " + std::to_string(i));
-  traits.set_supported_custom_fan_modes(std::move(fan_modes));
-  traits.set_visual_min_temperature(0.0f);
-  traits.set_visual_max_temperature(30.0f);
-  traits.set_visual_temperature_step(1.0f);
-  traits.set_supports_current_temperature(true);
-  return traits;
+  const uint8_t lang = static_cast<uint8_t>(label_language_);
+  // Index 0 (HeaterMode::NONE) ist kein auswählbares Preset
+  traits_cache_.set_supported_custom_presets(
+      std::set<std::string>(HEATER_MODE_LABELS[lang] + 1, HEATER_MODE_LABELS[lang] + HEATER_MODE_COUNT));
+  traits_cache_.set_supported_custom_fan_modes(std::set<std::string>(FAN_LEVEL_LABELS[lang], FAN_LEVEL_LABELS[lang] + 10));
+  traits_cache_.set_visual_min_temperature(0.0f);
+  traits_cache_.set_visual_max_temperature(30.0f);
+  traits_cache_.set_visual_temperature_step(1.0f);
+  traits_cache_.set_supports_current_temperature(true);
+  traits_built_ = true;
 }
 
 void AutotermClimate::control(const climate::ClimateCall &call) {
@@ -1324,13 +4202,15 @@ void AutotermClimate::control(const climate::ClimateCall &call) {
   if (call.get_mode().has_value())
     new_mode = *call.get_mode();
 
-  std::string new_preset = preset_mode_;
+  HeaterMode new_heater_mode = heater_mode_;
   bool preset_overridden = false;
   if (call.get_custom_preset().has_value()) {
-    new_preset = sanitize_preset_(*call.get_custom_preset());
+    new_heater_mode = parse_preset_(*call.get_custom_preset());
     preset_overridden = true;
   } else if (call.get_preset().has_value()) {
-    new_preset = sanitize_preset_(preset_from_enum_(*call.get_preset()));
+    HeaterMode requested = heater_mode_from_enum_(*call.get_preset());
+    if (requested != HeaterMode::NONE)
+      new_heater_mode = requested;
     preset_overridden = true;
   }
 
@@ -1338,20 +4218,15 @@ void AutotermClimate::control(const climate::ClimateCall &call) {
     switch (new_mode) {
       case climate::CLIMATE_MODE_FAN_ONLY:
       case climate::CLIMATE_MODE_OFF:
-        new_preset.clear();
+        new_heater_mode = HeaterMode::NONE;
         break;
       case climate::CLIMATE_MODE_AUTO:
-        if (new_preset.empty())
-          new_preset = "Heizen+Lüften";
-        break;
       case climate::CLIMATE_MODE_HEAT:
       default:
-        if (new_preset.empty())
-          new_preset = "Leistungsmodus";
+        if (new_heater_mode == HeaterMode::NONE)
+          new_heater_mode = last_heating_mode_;
         break;
     }
-    if (!new_preset.empty())
-      new_preset = sanitize_preset_(new_preset);
   }
 
   uint8_t new_level = fan_level_;
@@ -1366,11 +4241,13 @@ void AutotermClimate::control(const climate::ClimateCall &call) {
     new_target_temp = clamp_temperature_(*call.get_target_temperature());
 
   ESP_LOGD("autoterm_uart", "Climate control -> mode=%d preset=%s level=%u target=%.1f°C",
-           static_cast<int>(new_mode), new_preset.c_str(), new_level, new_target_temp);
+           static_cast<int>(new_mode), heater_mode_label(new_heater_mode), new_level, new_target_temp);
 
   if (!parent_) {
     ESP_LOGW("autoterm_uart", "Climate control requested without parent link");
-    apply_state_(new_mode, new_preset, new_level, new_target_temp);
+    apply_state_(new_mode, new_heater_mode, new_level, new_target_temp);
+    mark_dirty_(DIRTY_MODE, true);
+    flush_publish(millis());
     return;
   }
 
@@ -1379,45 +4256,46 @@ void AutotermClimate::control(const climate::ClimateCall &call) {
                       previous_mode == climate::CLIMATE_MODE_FAN_ONLY ||
                       !parent_->settings_valid_;
 
-  if (new_mode == climate::CLIMATE_MODE_OFF) {
+  ControlState state = STATE_HEATING;
+  if (previous_mode == climate::CLIMATE_MODE_OFF)
+    state = STATE_OFF;
+  else if (previous_mode == climate::CLIMATE_MODE_FAN_ONLY)
+    state = STATE_FAN_ONLY;
+  uint8_t target = 2 + static_cast<uint8_t>(new_heater_mode);
+  if (new_mode == climate::CLIMATE_MODE_OFF)
+    target = 0;
+  else if (new_mode == climate::CLIMATE_MODE_FAN_ONLY)
+    target = 1;
+  const uint8_t steps = CONTROL_TRANSITIONS[state][target];
+
+  if (steps & STEP_DISABLE_THERMOSTAT)
     parent_->disable_thermostat_mode();
+  if (steps & STEP_STANDBY)
     parent_->send_standby();
-  } else if (new_mode == climate::CLIMATE_MODE_FAN_ONLY) {
-    parent_->disable_thermostat_mode();
-    if (previous_mode != climate::CLIMATE_MODE_OFF)
-      parent_->send_standby();
+  if (steps & STEP_FAN_ONLY)
     parent_->send_fan_only(new_level);
-  } else {
-    if (previous_mode == climate::CLIMATE_MODE_FAN_ONLY)
-      parent_->send_standby();
-
-    if (new_preset == "Leistungsmodus") {
-      parent_->disable_thermostat_mode();
-      parent_->send_power_mode(should_start, new_level);
-    } else if (new_preset == "Heizen") {
-      parent_->disable_thermostat_mode();
-      uint8_t sensor = resolve_temp_sensor_();
-      uint8_t temp_byte = static_cast<uint8_t>(std::round(new_target_temp));
+  if (steps & STEP_POWER)
+    parent_->send_power_mode(should_start, new_level);
+  if (steps & (STEP_HOLD | STEP_HEAT_FAN)) {
+    uint8_t sensor = resolve_temp_sensor_();
+    uint8_t temp_byte = static_cast<uint8_t>(std::round(new_target_temp));
+    if (steps & STEP_HOLD)
       parent_->send_temperature_hold_mode(should_start, sensor, temp_byte);
-    } else if (new_preset == "Heizen+Lüften") {
-      parent_->disable_thermostat_mode();
-      uint8_t sensor = resolve_temp_sensor_();
-      uint8_t temp_byte = static_cast<uint8_t>(std::round(new_target_temp));
+    else
       parent_->send_temperature_to_fan_mode(should_start, sensor, temp_byte);
-    } else if (new_preset == "Thermostat") {
-      uint8_t sensor = resolve_temp_sensor_();
-      parent_->configure_thermostat_mode(new_target_temp, new_level, sensor,
-                                         thermostat_hys_on_c_, thermostat_hys_off_c_);
-    } else {
-      parent_->disable_thermostat_mode();
-    }
   }
-
-  apply_state_(new_mode, new_preset, new_level, new_target_temp);
+  if (steps & STEP_THERMOSTAT)
+    parent_->configure_thermostat_mode(new_target_temp, new_level, resolve_temp_sensor_(), thermostat_hys_on_c_,
+                                       thermostat_hys_off_c_);
+
+  apply_state_(new_mode, new_heater_mode, new_level, new_target_temp);
+  // Antwort auf einen Steuerbefehl sofort veröffentlichen, auch ohne Feldänderung
+  mark_dirty_(DIRTY_MODE, true);
+  flush_publish(millis());
 }
 
 void AutotermClimate::handle_status_update(uint16_t status_code, float internal_temp) {
-  bool changed = false;
+  uint8_t dirty = 0;
   float display_temp = internal_temp;
   if (parent_ != nullptr) {
     uint8_t source = parent_->get_effective_temp_source();
@@ -1430,27 +4308,33 @@ void AutotermClimate::handle_status_update(uint16_t status_code, float internal_
     if (std::isnan(current_temperature_c_) || std::fabs(display_temp - current_temperature_c_) > 0.1f) {
       current_temperature_c_ = display_temp;
       this->current_temperature = display_temp;
-      changed = true;
+      dirty |= DIRTY_CURRENT;
     }
   }
 
   climate::ClimateAction previous_action = this->action;
   update_action_from_status_(status_code);
   if (this->action != previous_action)
-    changed = true;
+    dirty |= DIRTY_ACTION;
 
-  if (changed)
-    this->publish_state();
+  mark_dirty_(dirty);
 }
 
-void AutotermClimate::handle_settings_update(const AutotermUART::Settings &settings, bool from_display) {
-  if (!from_display)
-    return;
+void AutotermClimate::handle_settings_update(const AutotermUART::Settings &settings, uint16_t status_code) {
   uint8_t level = clamp_level_(settings.power_level);
   float target = clamp_temperature_(static_cast<float>(settings.set_temperature));
-  std::string preset = deduce_preset_from_settings_(settings);
-  climate::ClimateMode mode = deduce_mode_from_settings_(settings);
-  apply_state_(mode, preset, level, target);
+  HeaterMode heater_mode = deduce_heater_mode_from_settings_(settings);
+  // Die Settings kennen keinen Betriebszustand: Aus/Lüften kommt aus dem Status, Abschaltphasen behalten den Modus
+  climate::ClimateMode mode = this->mode;
+  if (status_code == 0x0000 || status_code == 0x0001)
+    mode = climate::CLIMATE_MODE_OFF;
+  else if (status_code == 0x0101 || status_code == 0x0323)
+    mode = climate::CLIMATE_MODE_FAN_ONLY;
+  else if ((status_code & 0xFF00) == 0x0200 || status_code == 0x0300)
+    mode = deduce_mode_from_settings_(settings);
+  if (mode == climate::CLIMATE_MODE_OFF)
+    heater_mode = HeaterMode::NONE;
+  apply_state_(mode, heater_mode, level, target);
 }
 
 uint8_t AutotermClimate::clamp_level_(int level) {
@@ -1485,31 +4369,52 @@ float AutotermClimate::clamp_hysteresis_off_(float value) {
   return value;
 }
 
-std::string AutotermClimate::fan_mode_label_from_level_(uint8_t level) const {
-  level = clamp_level_(level);
-  return "Stufe " + std::to_string(static_cast<int>(level));
+uint8_t AutotermClimate::fan_mode_label_to_level_(const std::string &label) const {
+  // Beide Sprachen akzeptieren, damit Automationen unabhängig von der Anzeige funktionieren
+  for (uint8_t lang = 0; lang < LABEL_LANGUAGE_COUNT; lang++) {
+    for (uint8_t i = 0; i < 10; i++) {
+      if (label == FAN_LEVEL_LABELS[lang][i])
+        return i;
+    }
+  }
+  return fan_level_;
 }
 
-uint8_t AutotermClimate::fan_mode_label_to_level_(const std::string &label) const {
-  const std::string prefix = "Stufe ";
-  if (label.size() <= prefix.size() || label.compare(0, prefix.size(), prefix) != 0)
-    return fan_level_;
-  std::string digits = label.substr(prefix.size());
-  if (digits.empty())
-    return fan_level_;
-  int value = 0;
-  for (char c : digits) {
-    if (!std::isdigit(static_cast<unsigned char>(c)))
-      return fan_level_;
-    value = value * 10 + (c - '0');
+bool AutotermClimate::assign_label_(optional<std::string> &field, const char *label) {
+  if (label == nullptr) {
+    if (!field.has_value())
+      return false;
+    field.reset();
+    return true;
+  }
+  // Gleiches Label nicht neu zuweisen
+  if (field.has_value() && *field == label)
+    return false;
+  field = std::string(label);
+  return true;
+}
+
+HeaterMode AutotermClimate::parse_preset_(const std::string &preset) const {
+  for (uint8_t lang = 0; lang < LABEL_LANGUAGE_COUNT; lang++) {
+    for (uint8_t i = 1; i < HEATER_MODE_COUNT; i++) {
+      if (preset == HEATER_MODE_LABELS[lang][i])
+        return static_cast<HeaterMode>(i);
+    }
   }
-  return clamp_level_(value);
+  return heater_mode_;
 }
 
-std::string AutotermClimate::sanitize_preset_(const std::string &preset) const {
-  if (preset == "Leistungsmodus" || preset == "Heizen" || preset == "Heizen+Lüften" || preset == "Thermostat")
-    return preset;
-  return preset_mode_;
+uint8_t AutotermClimate::publish_labels_() {
+  uint8_t dirty = 0;
+  if (assign_label_(this->custom_fan_mode, fan_level_label(fan_level_, label_language_)))
+    dirty |= DIRTY_FAN_MODE;
+  const char *preset_label = nullptr;
+  if (this->mode != climate::CLIMATE_MODE_FAN_ONLY && this->mode != climate::CLIMATE_MODE_OFF &&
+      heater_mode_ != HeaterMode::NONE)
+    preset_label = heater_mode_label(heater_mode_, label_language_);
+  if (assign_label_(this->custom_preset, preset_label))
+    dirty |= DIRTY_PRESET;
+  return dirty;
 }
 
 uint8_t AutotermClimate::resolve_temp_sensor_() const {
@@ -1543,33 +4448,33 @@ climate::ClimateMode AutotermClimate::deduce_mode_from_settings_(const AutotermU
   return this->mode;
 }
 
-std::string AutotermClimate::deduce_preset_from_settings_(const AutotermUART::Settings &settings) const {
+HeaterMode AutotermClimate::deduce_heater_mode_from_settings_(const AutotermUART::Settings &settings) const {
   if (settings.temperature_source == 0x04)
-    return "Leistungsmodus";
+    return HeaterMode::POWER;
   if (settings.wait_mode == 0x01)
-    return "Heizen+Lüften";
+    return HeaterMode::HEAT_FAN;
   if (settings.wait_mode == 0x02)
-    return "Heizen";
-  return preset_mode_;
+    return HeaterMode::HEAT;
+  return heater_mode_;
 }
 
-std::string AutotermClimate::preset_from_enum_(climate::ClimatePreset preset) {
+HeaterMode AutotermClimate::heater_mode_from_enum_(climate::ClimatePreset preset) {
   switch (preset) {
     case climate::CLIMATE_PRESET_NONE:
-      return "Leistungsmodus";
+      return HeaterMode::POWER;
     case climate::CLIMATE_PRESET_HOME:
     case climate::CLIMATE_PRESET_COMFORT:
     case climate::CLIMATE_PRESET_SLEEP:
-      return "Heizen";
+      return HeaterMode::HEAT;
     case climate::CLIMATE_PRESET_AWAY:
     case climate::CLIMATE_PRESET_ACTIVITY:
-      return "Heizen+Lüften";
+      return HeaterMode::HEAT_FAN;
     case climate::CLIMATE_PRESET_BOOST:
-      return "Leistungsmodus";
+      return HeaterMode::POWER;
     case climate::CLIMATE_PRESET_ECO:
-      return "Thermostat";
+      return HeaterMode::THERMOSTAT;
     default:
-      return "";
+      return HeaterMode::NONE;
   }
 }
 
@@ -1600,38 +4505,68 @@ uint8_t AutotermClimate::fan_level_from_enum_(climate::ClimateFanMode mode, uint
   }
 }
 
-void AutotermClimate::apply_state_(climate::ClimateMode mode, const std::string &preset, uint8_t level, float target_temp) {
-  preset_mode_ = sanitize_preset_(preset);
+void AutotermClimate::apply_state_(climate::ClimateMode mode, HeaterMode heater_mode, uint8_t level, float target_temp) {
+  heater_mode_ = heater_mode;
+  if (heater_mode != HeaterMode::NONE)
+    last_heating_mode_ = heater_mode;
   fan_level_ = clamp_level_(level);
   target_temperature_c_ = clamp_temperature_(target_temp);
 
+  uint8_t dirty = 0;
+  bool mode_changed = this->mode != mode;
+  if (mode_changed)
+    dirty |= DIRTY_MODE;
   this->mode = mode;
   this->preset.reset();
-  if (mode != climate::CLIMATE_MODE_FAN_ONLY && mode != climate::CLIMATE_MODE_OFF && !preset_mode_.empty())
-    this->custom_preset = preset_mode_;
-  else
-    this->custom_preset.reset();
   this->fan_mode.reset();
-  {
-    std::string fan_label = fan_mode_label_from_level_(fan_level_);
-    if (!fan_label.empty())
-      this->custom_fan_mode = fan_label;
-    else
-      this->custom_fan_mode.reset();
-  }
+  dirty |= publish_labels_();
+  if (this->target_temperature != target_temperature_c_)
+    dirty |= DIRTY_TARGET;
   this->target_temperature = target_temperature_c_;
   if (!std::isnan(current_temperature_c_))
     this->current_temperature = current_temperature_c_;
   else
     this->current_temperature = NAN;
 
-  if (mode == climate::CLIMATE_MODE_OFF)
-    this->action = climate::CLIMATE_ACTION_OFF;
-  else if (mode == climate::CLIMATE_MODE_FAN_ONLY)
-    this->action = climate::CLIMATE_ACTION_FAN;
-  else
-    this->action = climate::CLIMATE_ACTION_HEATING;
+  // Aktion nur beim Moduswechsel vorbelegen, sonst liefert der Status die genauere Aktion
+  if (mode_changed) {
+    climate::ClimateAction action = climate::CLIMATE_ACTION_HEATING;
+    if (mode == climate::CLIMATE_MODE_OFF)
+      action = climate::CLIMATE_ACTION_OFF;
+    else if (mode == climate::CLIMATE_MODE_FAN_ONLY)
+      action = climate::CLIMATE_ACTION_FAN;
+    if (this->action != action)
+      dirty |= DIRTY_ACTION;
+    this->action = action;
+  }
 
+  mark_dirty_(dirty);
+}
+
+void AutotermClimate::mark_dirty_(uint8_t fields, bool immediate) {
+  if (fields == 0)
+    return;
+  // Nur mitzählen, wenn eine noch ausstehende Veröffentlichung diese Änderung mit aufnimmt
+  if (dirty_ != 0)
+    suppressed_publish_count_++;
+  dirty_ |= fields;
+  if (immediate)
+    publish_immediately_ = true;
+}
+
+void AutotermClimate::flush_publish(uint32_t now) {
+  if (suppressed_publish_sensor_ != nullptr && (now - last_stats_publish_millis_) >= 60000) {
+    last_stats_publish_millis_ = now;
+    suppressed_publish_sensor_->publish_state(static_cast<float>(suppressed_publish_count_));
+  }
+  if (dirty_ == 0)
+    return;
+  if (!publish_immediately_ && publish_count_ != 0 && (now - last_publish_millis_) < min_publish_interval_ms_)
+    return;
+  dirty_ = 0;
+  publish_immediately_ = false;
+  last_publish_millis_ = now;
+  publish_count_++;
   this->publish_state();
 }
 
@@ -1671,14 +4606,333 @@ void AutotermClimate::update_action_from_status_(uint16_t status_code) {
   this->action = action;
 }
 
+void AutotermUART::flush_climate_publish_(uint32_t now) { climate_->flush_publish(now); }
+
 void AutotermUART::set_climate(AutotermClimate *climate) {
   climate_ = climate;
   if (climate_ != nullptr) {
     climate_->set_parent(this);
     if (settings_valid_)
-      climate_->handle_settings_update(settings_, false);
+      climate_->handle_settings_update(settings_, snapshot_.status_valid ? snapshot_.status_code : 0xFFFF);
   }
 }
 
+#ifdef USE_AUTOTERM_METRICS
+// ===================
+// /metrics im Prometheus-Textformat auf dem vorhandenen web_server
+// ===================
+class AutotermMetricsHandler : public AsyncWebHandler {
+ public:
+  AutotermMetricsHandler(AutotermUART *parent, const char *path) : parent_(parent), path_(path) {}
+  bool canHandle(AsyncWebServerRequest *request) const override {
+    return request->method() == HTTP_GET && request->url() == path_;
+  }
+  void handleRequest(AsyncWebServerRequest *request) override {
+    size_t length = 0;
+    const char *body = parent_->get_metrics(length);
+    if (body == nullptr) {
+      request->send(503, "text/plain", "metrics not rendered yet\n");
+      return;
+    }
+    // Antwort liest direkt aus dem Puffer; überschrieben wird er frühestens ein Renderintervall nach dem Umschalten
+    request->send(request->beginResponse(200, "text/plain; version=0.0.4; charset=utf-8",
+                                         reinterpret_cast<const uint8_t *>(body), length));
+  }
+
+ protected:
+  AutotermUART *parent_;
+  const char *path_;
+};
+
+void AutotermUART::set_metrics_server(web_server_base::WebServerBase *base, const char *path) {
+  // Einmalig beim Start; der Handler lebt so lange wie die Komponente
+  base->add_handler(new AutotermMetricsHandler(this, path));  // NOLINT
+}
+
+void AutotermUART::metrics_append_(const char *format, ...) {
+  if (metrics_overflow_)
+    return;
+  va_list args;
+  va_start(args, format);
+  int written = vsnprintf(metrics_target_ + metrics_length_, METRICS_BUFFER_SIZE - metrics_length_, format, args);
+  va_end(args);
+  if (written < 0 || static_cast<size_t>(written) >= METRICS_BUFFER_SIZE - metrics_length_) {
+    metrics_overflow_ = true;
+    return;
+  }
+  metrics_length_ += written;
+}
+
+void AutotermUART::render_metrics_(uint32_t now) {
+  static const char *const DIRECTIONS[2] = {"display", "heater"};
+  static const char *const BUS_COUNTER_METRICS[BUS_COUNTER_COUNT] = {
+      "frames_ok", "crc_errors", "resyncs", "aborted_frames", "stray_bytes", "injected_frames", "rewritten_frames",
+  };
+  metrics_last_render_millis_ = now;
+  int8_t back = metrics_front_.load(std::memory_order_relaxed) == 0 ? 1 : 0;
+  metrics_target_ = metrics_buffers_[back];
+  metrics_length_ = 0;
+  metrics_overflow_ = false;
+  metrics_target_[0] = '\0';
+
+  for (uint8_t c = 0; c < BUS_COUNTER_COUNT; c++) {
+    metrics_append_("# TYPE autoterm_bus_%s_total counter\n", BUS_COUNTER_METRICS[c]);
+    for (uint8_t d = 0; d < 2; d++)
+      metrics_append_("autoterm_bus_%s_total{direction=\"%s\"} %u\n", BUS_COUNTER_METRICS[c], DIRECTIONS[d],
+                      static_cast<unsigned>(get_bus_counter(d, c)));
+  }
+
+#ifdef USE_AUTOTERM_LATENCY
+  metrics_append_("# TYPE autoterm_forward_latency_seconds histogram\n");
+  for (uint8_t d = 0; d < 2; d++) {
+    const LatencyHistogram &h = latency_total_[d];
+    uint32_t cumulative = 0;
+    for (uint8_t i = 0; i + 1 < LatencyHistogram::BUCKETS; i++) {
+      cumulative += h.counts[i];
+      metrics_append_("autoterm_forward_latency_seconds_bucket{direction=\"%s\",le=\"%g\"} %u\n", DIRECTIONS[d],
+                      LatencyHistogram::BUCKET_LIMITS_US[i] / 1e6, static_cast<unsigned>(cumulative));
+    }
+    metrics_append_("autoterm_forward_latency_seconds_bucket{direction=\"%s\",le=\"+Inf\"} %u\n", DIRECTIONS[d],
+                    static_cast<unsigned>(h.total));
+    metrics_append_("autoterm_forward_latency_seconds_sum{direction=\"%s\"} %.6f\n", DIRECTIONS[d], h.sum_us / 1e6);
+    metrics_append_("autoterm_forward_latency_seconds_count{direction=\"%s\"} %u\n", DIRECTIONS[d],
+                    static_cast<unsigned>(h.total));
+  }
+  metrics_append_("# TYPE autoterm_loop_time_seconds_total counter\nautoterm_loop_time_seconds_total %.6f\n",
+                  loop_time_total_us_ / 1e6);
+  metrics_append_("# TYPE autoterm_loop_iterations_total counter\nautoterm_loop_iterations_total %u\n",
+                  static_cast<unsigned>(loop_iterations_total_));
+  metrics_append_("# TYPE autoterm_loop_time_max_seconds gauge\nautoterm_loop_time_max_seconds %.6f\n",
+                  loop_time_max_us_ / 1e6);
+#endif
+
+  metrics_append_("# TYPE autoterm_ignitions_total counter\nautoterm_ignitions_total %u\n",
+                  static_cast<unsigned>(ignitions_));
+  metrics_append_("# TYPE autoterm_ignition_failures_total counter\nautoterm_ignition_failures_total %u\n",
+                  static_cast<unsigned>(ignition_failures_));
+#ifdef USE_AUTOTERM_RUNTIME
+  metrics_append_("# TYPE autoterm_runtime_seconds_total counter\nautoterm_runtime_seconds_total %.0f\n",
+                  runtime_hours_ * 3600.0);
+#endif
+
+  if (snapshot_.status_valid) {
+    metrics_append_("# TYPE autoterm_heater_status gauge\nautoterm_heater_status %u\n",
+                    static_cast<unsigned>(snapshot_.status_code));
+    metrics_append_("# TYPE autoterm_heater_fault_code gauge\nautoterm_heater_fault_code %u\n",
+                    static_cast<unsigned>(snapshot_.fault_code));
+    metrics_append_("# TYPE autoterm_supply_voltage_volts gauge\nautoterm_supply_voltage_volts %.1f\n",
+                    snapshot_.voltage_v);
+    metrics_append_("# TYPE autoterm_temperature_celsius gauge\n");
+    const struct {
+      const char *name;
+      float value;
+    } temps[] = {{"internal", snapshot_.internal_temp_c},
+                 {"external", snapshot_.external_temp_c},
+                 {"heater", snapshot_.heater_temp_c},
+                 {"panel", snapshot_.panel_temp_c}};
+    for (const auto &t : temps) {
+      if (std::isfinite(t.value))
+        metrics_append_("autoterm_temperature_celsius{sensor=\"%s\"} %.1f\n", t.name, t.value);
+    }
+    metrics_append_("# TYPE autoterm_fan_speed_rpm gauge\nautoterm_fan_speed_rpm{kind=\"set\"} %.0f\n"
+                    "autoterm_fan_speed_rpm{kind=\"actual\"} %.0f\n",
+                    snapshot_.fan_speed_set_rpm, snapshot_.fan_speed_actual_rpm);
+    metrics_append_("# TYPE autoterm_pump_frequency_hertz gauge\nautoterm_pump_frequency_hertz %.2f\n",
+                    snapshot_.pump_frequency_hz);
+  }
+  metrics_append_("# TYPE autoterm_heater_running gauge\nautoterm_heater_running %u\n", heater_running_ ? 1u : 0u);
+  metrics_append_("# TYPE autoterm_display_connected gauge\nautoterm_display_connected %u\n",
+                  display_connected_state_ ? 1u : 0u);
+
+#ifdef USE_AUTOTERM_DECODE_CACHE
+  metrics_append_("# TYPE autoterm_decode_cache_hits_total counter\n"
+                  "autoterm_decode_cache_hits_total{frame=\"status\"} %u\n"
+                  "autoterm_decode_cache_hits_total{frame=\"settings\"} %u\n",
+                  static_cast<unsigned>(decode_cache_hits_[DECODE_CACHE_STATUS]),
+                  static_cast<unsigned>(decode_cache_hits_[DECODE_CACHE_SETTINGS]));
+  metrics_append_("# TYPE autoterm_decode_cache_misses_total counter\n"
+                  "autoterm_decode_cache_misses_total{frame=\"status\"} %u\n"
+                  "autoterm_decode_cache_misses_total{frame=\"settings\"} %u\n",
+                  static_cast<unsigned>(decode_cache_misses_[DECODE_CACHE_STATUS]),
+                  static_cast<unsigned>(decode_cache_misses_[DECODE_CACHE_SETTINGS]));
+#endif
+#ifdef USE_AUTOTERM_COMMAND_WINDOW
+  metrics_append_("# TYPE autoterm_commands_coalesced_total counter\nautoterm_commands_coalesced_total %u\n",
+                  static_cast<unsigned>(commands_coalesced_));
+#endif
+#ifdef USE_AUTOTERM_RECONCILE
+  metrics_append_("# TYPE autoterm_commands_skipped_total counter\nautoterm_commands_skipped_total %u\n",
+                  static_cast<unsigned>(commands_skipped_));
+  metrics_append_("# TYPE autoterm_reconcile_corrections_total counter\nautoterm_reconcile_corrections_total %u\n",
+                  static_cast<unsigned>(reconcile_corrections_));
+#endif
+#ifdef USE_AUTOTERM_BATTERY_GOVERNOR
+  metrics_append_("# TYPE autoterm_battery_governor_state gauge\nautoterm_battery_governor_state %u\n",
+                  static_cast<unsigned>(battery_state_));
+  metrics_append_("# TYPE autoterm_battery_level_cap gauge\nautoterm_battery_level_cap %u\n", battery_level_cap_);
+  if (std::isfinite(battery_filtered_v_)) {
+    metrics_append_("# TYPE autoterm_battery_filtered_volts gauge\nautoterm_battery_filtered_volts %.3f\n",
+                    battery_filtered_v_);
+    metrics_append_("# TYPE autoterm_battery_trend_volts_per_hour gauge\nautoterm_battery_trend_volts_per_hour %.3f\n",
+                    battery_trend_vph_);
+  }
+  metrics_append_("# TYPE autoterm_battery_blocked_starts_total counter\nautoterm_battery_blocked_starts_total %u\n",
+                  static_cast<unsigned>(battery_blocked_starts_));
+#endif
+#ifdef USE_AUTOTERM_TELEMETRY
+  metrics_append_("# TYPE autoterm_telemetry_records_total counter\n"
+                  "autoterm_telemetry_records_total{result=\"sent\"} %u\n"
+                  "autoterm_telemetry_records_total{result=\"dropped\"} %u\n",
+                  static_cast<unsigned>(telemetry_sent_), static_cast<unsigned>(telemetry_dropped_));
+#endif
+
+#ifdef USE_ESP32
+  metrics_append_("# TYPE autoterm_heap_free_bytes gauge\nautoterm_heap_free_bytes %u\n",
+                  static_cast<unsigned>(heap_caps_get_free_size(MALLOC_CAP_INTERNAL)));
+  metrics_append_("# TYPE autoterm_heap_largest_free_block_bytes gauge\nautoterm_heap_largest_free_block_bytes %u\n",
+                  static_cast<unsigned>(heap_caps_get_largest_free_block(MALLOC_CAP_INTERNAL)));
+#endif
+
+  if (metrics_overflow_) {
+    // Vorderen Puffer behalten; ein abgeschnittener Text wäre für Prometheus ungültig
+    ESP_LOGW("autoterm_uart", "/metrics: Puffer (%u Byte) zu klein", static_cast<unsigned>(METRICS_BUFFER_SIZE));
+    return;
+  }
+  metrics_lengths_[back] = metrics_length_;
+  metrics_front_.store(back, std::memory_order_release);
+}
+#endif
+
+// ===================
+// Automation-Trigger
+// ===================
+#ifdef USE_AUTOTERM_ON_PHASE_CHANGE
+class PhaseChangeTrigger : public Trigger<uint16_t, uint16_t> {
+ public:
+  explicit PhaseChangeTrigger(AutotermUART *parent) {
+    parent->add_on_phase_change_callback(
+        [this](uint16_t status, uint16_t previous) { this->trigger(status, previous); });
+  }
+};
+#endif
+
+#ifdef USE_AUTOTERM_ON_IGNITION_FAILED
+class IgnitionFailedTrigger : public Trigger<uint16_t> {
+ public:
+  explicit IgnitionFailedTrigger(AutotermUART *parent) {
+    parent->add_on_ignition_failed_callback([this](uint16_t status) { this->trigger(status); });
+  }
+};
+#endif
+
+#ifdef USE_AUTOTERM_ON_FRAME
+class FrameTrigger : public Trigger<bool, uint8_t, const std::vector<uint8_t> &> {
+ public:
+  enum Direction : uint8_t { DIRECTION_ANY = 0, DIRECTION_DISPLAY, DIRECTION_HEATER };
+
+  explicit FrameTrigger(AutotermUART *parent) {
+    parent->add_on_frame_callback([this](bool from_display, uint8_t command, const std::vector<uint8_t> &frame) {
+      if (direction_ == DIRECTION_DISPLAY && !from_display)
+        return;
+      if (direction_ == DIRECTION_HEATER && from_display)
+        return;
+      if (command_ >= 0 && command != command_)
+        return;
+      this->trigger(from_display, command, frame);
+    });
+  }
+  void set_direction(Direction direction) { direction_ = direction; }
+  void set_command(uint8_t command) { command_ = command; }
+
+ protected:
+  Direction direction_{DIRECTION_ANY};
+  int16_t command_{-1};
+};
+#endif
+
+#ifdef USE_AUTOTERM_ON_DISPLAY_CONNECTED
+class DisplayConnectedTrigger : public Trigger<> {
+ public:
+  explicit DisplayConnectedTrigger(AutotermUART *parent) {
+    parent->add_on_display_connected_callback([this]() { this->trigger(); });
+  }
+};
+#endif
+
+#ifdef USE_AUTOTERM_ON_DISPLAY_LOST
+class DisplayLostTrigger : public Trigger<> {
+ public:
+  explicit DisplayLostTrigger(AutotermUART *parent) {
+    parent->add_on_display_lost_callback([this]() { this->trigger(); });
+  }
+};
+#endif
+
+#ifdef USE_AUTOTERM_ON_THERMOSTAT_CYCLE
+class ThermostatCycleTrigger : public Trigger<bool, float> {
+ public:
+  explicit ThermostatCycleTrigger(AutotermUART *parent) {
+    parent->add_on_thermostat_cycle_callback([this](bool heating, float temperature) {
+      this->trigger(heating, temperature);
+    });
+  }
+};
+#endif
+
+#ifdef USE_AUTOTERM_BATTERY_GOVERNOR
+class BatteryGovernorTrigger : public Trigger<std::string, float> {
+ public:
+  explicit BatteryGovernorTrigger(AutotermUART *parent) {
+    parent->add_on_battery_governor_callback([this](std::string state, float voltage) {
+      this->trigger(state, voltage);
+    });
+  }
+};
+#endif
+
+// ===================
+// Automation-Aktionen
+// ===================
+#ifdef USE_AUTOTERM_PREHEAT
+template<typename... Ts> class PreheatScheduleAction : public Action<Ts...>, public Parented<AutotermUART> {
+ public:
+  TEMPLATABLE_VALUE(uint8_t, hour)
+  TEMPLATABLE_VALUE(uint8_t, minute)
+  TEMPLATABLE_VALUE(float, target_temperature)
+
+  void play(Ts... x) override {
+    float target = this->target_temperature_.has_value() ? this->target_temperature_.value(x...)
+                                                         : this->parent_->get_preheat_default_target();
+    this->parent_->schedule_preheat(this->hour_.value(x...), this->minute_.value(x...), target);
+  }
+};
+
+template<typename... Ts> class PreheatCancelAction : public Action<Ts...>, public Parented<AutotermUART> {
+ public:
+  void play(Ts... x) override { this->parent_->cancel_preheat(); }
+};
+#endif
+
+#ifdef USE_AUTOTERM_BENCHMARK
+template<typename... Ts> class BenchmarkAction : public Action<Ts...>, public Parented<AutotermUART> {
+ public:
+  void set_iterations(uint32_t iterations) { iterations_ = iterations; }
+  void play(Ts... x) override { this->parent_->run_benchmark(iterations_); }
+
+ protected:
+  uint32_t iterations_{1000};
+};
+#endif
+
+template<typename... Ts> class FaultHistoryDumpAction : public Action<Ts...>, public Parented<AutotermUART> {
+ public:
+  void play(Ts... x) override { this->parent_->dump_fault_history(); }
+};
+
+template<typename... Ts> class FaultHistoryClearAction : public Action<Ts...>, public Parented<AutotermUART> {
+ public:
+  void play(Ts... x) override { this->parent_->clear_fault_history(); }
+};
+
 }  // namespace autoterm_uart
 }  // namespace esphome
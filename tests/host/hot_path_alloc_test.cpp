@@ -0,0 +1,153 @@
+// Spielt den Mitschnitt logs_air2d_run_Thermostat.txt Frame für Frame durch loop() und prüft,
+// dass Framing, Weiterleitung und Dekodierung nach setup() keinen Heap mehr anfordern.
+// Der zählende operator new lebt nur in diesem Host-Test, nie in der Firmware.
+#include "autoterm_uart.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <new>
+#include <string>
+
+namespace esphome {
+extern uint32_t host_millis;
+}  // namespace esphome
+
+static bool g_counting = false;
+static uint32_t g_allocations = 0;
+
+void *operator new(std::size_t size) {
+  if (g_counting)
+    g_allocations++;
+  void *p = std::malloc(size == 0 ? 1 : size);
+  if (p == nullptr)
+    throw std::bad_alloc();
+  return p;
+}
+void *operator new[](std::size_t size) { return operator new(size); }
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t) noexcept { std::free(p); }
+
+using namespace esphome;
+using namespace esphome::autoterm_uart;
+
+struct HostUart : uart::UARTComponent {
+  std::deque<uint8_t> rx;
+  size_t tx_bytes{0};
+  void write_array(const uint8_t *data, size_t len) override { tx_bytes += len; }
+  bool read_array(uint8_t *data, size_t len) override {
+    if (rx.size() < len)
+      return false;
+    for (size_t i = 0; i < len; i++) {
+      data[i] = rx.front();
+      rx.pop_front();
+    }
+    return true;
+  }
+  bool peek_byte(uint8_t *data) override {
+    if (rx.empty())
+      return false;
+    *data = rx.front();
+    return true;
+  }
+  int available() override { return static_cast<int>(rx.size()); }
+  void flush() override {}
+};
+
+struct LoggedFrame {
+  bool from_display;
+  uint32_t millis;
+  std::vector<uint8_t> bytes;
+};
+
+// Zeilen der Form "[17:22:10.864][D][autoterm_uart:311]: [display→heater] Frame (8 bytes): AA 03 ..."
+static bool parse_frame_line(const std::string &line, LoggedFrame &out) {
+  size_t marker = line.find("] Frame (");
+  if (marker == std::string::npos || line.size() < 14 || line[0] != '[')
+    return false;
+  bool from_display = line.find("[display→heater]") != std::string::npos;
+  if (!from_display && line.find("[heater→display]") == std::string::npos)
+    return false;
+  unsigned h, m, s, ms;
+  if (sscanf(line.c_str(), "[%u:%u:%u.%u]", &h, &m, &s, &ms) != 4)
+    return false;
+  size_t colon = line.find("): ", marker);
+  if (colon == std::string::npos)
+    return false;
+  out.from_display = from_display;
+  out.millis = ((h * 60 + m) * 60 + s) * 1000 + ms;
+  out.bytes.clear();
+  const char *p = line.c_str() + colon + 3;
+  unsigned value;
+  int consumed;
+  while (sscanf(p, "%x%n", &value, &consumed) == 1) {
+    out.bytes.push_back(static_cast<uint8_t>(value));
+    p += consumed;
+  }
+  return !out.bytes.empty();
+}
+
+int main(int argc, char **argv) {
+  if (argc < 2) {
+    fprintf(stderr, "Aufruf: %s <logs_air2d_run_Thermostat.txt>\n", argv[0]);
+    return 2;
+  }
+  std::ifstream log(argv[1]);
+  if (!log) {
+    fprintf(stderr, "Mitschnitt %s nicht lesbar\n", argv[1]);
+    return 2;
+  }
+  std::vector<LoggedFrame> frames;
+  std::string line;
+  LoggedFrame frame;
+  while (std::getline(log, line)) {
+    if (parse_frame_line(line, frame))
+      frames.push_back(frame);
+  }
+  if (frames.size() < 1000) {
+    fprintf(stderr, "Nur %zu Frames im Mitschnitt gefunden\n", frames.size());
+    return 2;
+  }
+
+  HostUart display, heater;
+  sensor::Sensor internal_temp, external_temp, heater_temp, voltage, status, fan_set, fan_actual, pump;
+  AutotermUART bridge;
+  bridge.set_uart_display(&display);
+  bridge.set_uart_heater(&heater);
+  bridge.set_internal_temp_sensor(&internal_temp);
+  bridge.set_external_temp_sensor(&external_temp);
+  bridge.set_heater_temp_sensor(&heater_temp);
+  bridge.set_voltage_sensor(&voltage);
+  bridge.set_status_sensor(&status);
+  bridge.set_fan_speed_set_sensor(&fan_set);
+  bridge.set_fan_speed_actual_sensor(&fan_actual);
+  bridge.set_pump_frequency_sensor(&pump);
+  host_millis = frames.front().millis;
+  bridge.setup();
+
+  size_t failures = 0;
+  for (size_t i = 0; i < frames.size(); i++) {
+    const LoggedFrame &f = frames[i];
+    // Vor dem ersten Zählen: die deque der Fake-UART darf wachsen, die Bridge nicht
+    (f.from_display ? display : heater).rx.insert((f.from_display ? display : heater).rx.end(), f.bytes.begin(),
+                                                   f.bytes.end());
+    host_millis = f.millis;
+    g_allocations = 0;
+    g_counting = true;
+    bridge.loop();
+    g_counting = false;
+    if (g_allocations != 0 && failures++ < 10)
+      fprintf(stderr, "Frame %zu (%s, cmd 0x%02X): %u Allokationen\n", i, f.from_display ? "display" : "heater",
+              f.bytes.size() > 4 ? f.bytes[4] : 0, static_cast<unsigned>(g_allocations));
+  }
+
+  if (display.tx_bytes == 0 || heater.tx_bytes == 0) {
+    fprintf(stderr, "Keine Weiterleitung beobachtet\n");
+    return 1;
+  }
+  printf("%zu Frames, %zu mit Allokationen\n", frames.size(), failures);
+  return failures == 0 ? 0 : 1;
+}
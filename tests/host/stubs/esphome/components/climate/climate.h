@@ -0,0 +1,56 @@
+#pragma once
+#include <set>
+#include <string>
+#include "esphome/core/component.h"
+#include "esphome/core/optional.h"
+namespace esphome { namespace climate {
+enum ClimateMode : uint8_t { CLIMATE_MODE_OFF, CLIMATE_MODE_HEAT_COOL, CLIMATE_MODE_COOL, CLIMATE_MODE_HEAT, CLIMATE_MODE_FAN_ONLY, CLIMATE_MODE_DRY, CLIMATE_MODE_AUTO };
+enum ClimateAction : uint8_t { CLIMATE_ACTION_OFF, CLIMATE_ACTION_COOLING=2, CLIMATE_ACTION_HEATING, CLIMATE_ACTION_IDLE, CLIMATE_ACTION_DRYING, CLIMATE_ACTION_FAN };
+enum ClimateFanMode : uint8_t { CLIMATE_FAN_ON, CLIMATE_FAN_OFF, CLIMATE_FAN_AUTO, CLIMATE_FAN_LOW, CLIMATE_FAN_MEDIUM, CLIMATE_FAN_HIGH, CLIMATE_FAN_MIDDLE, CLIMATE_FAN_FOCUS, CLIMATE_FAN_DIFFUSE, CLIMATE_FAN_QUIET };
+enum ClimatePreset : uint8_t { CLIMATE_PRESET_NONE, CLIMATE_PRESET_HOME, CLIMATE_PRESET_AWAY, CLIMATE_PRESET_BOOST, CLIMATE_PRESET_COMFORT, CLIMATE_PRESET_ECO, CLIMATE_PRESET_SLEEP, CLIMATE_PRESET_ACTIVITY };
+class ClimateTraits {
+ public:
+  void set_supported_modes(std::set<ClimateMode> modes);
+  void set_supported_custom_presets(std::set<std::string> presets);
+  void set_supported_custom_fan_modes(std::set<std::string> modes);
+  void set_visual_min_temperature(float v);
+  void set_visual_max_temperature(float v);
+  void set_visual_temperature_step(float v);
+  void set_supports_current_temperature(bool v);
+};
+class Climate;
+class ClimateCall {
+ public:
+  explicit ClimateCall(Climate *parent) : parent_(parent) {}
+  void perform();
+  ClimateCall &set_mode(ClimateMode mode);
+  ClimateCall &set_target_temperature(float t);
+  ClimateCall &set_preset(const std::string &preset);
+  ClimateCall &set_fan_mode(const std::string &fan_mode);
+  const optional<ClimateMode> &get_mode() const;
+  const optional<float> &get_target_temperature() const;
+  const optional<ClimateFanMode> &get_fan_mode() const;
+  const optional<std::string> &get_custom_fan_mode() const;
+  const optional<ClimatePreset> &get_preset() const;
+  const optional<std::string> &get_custom_preset() const;
+ protected:
+  Climate *parent_;
+};
+class Climate : public EntityBase {
+ public:
+  ClimateMode mode{CLIMATE_MODE_OFF};
+  ClimateAction action{CLIMATE_ACTION_OFF};
+  float current_temperature{0};
+  float target_temperature{0};
+  optional<ClimateFanMode> fan_mode;
+  optional<std::string> custom_fan_mode;
+  optional<ClimatePreset> preset;
+  optional<std::string> custom_preset;
+  ClimateCall make_call();
+  void publish_state();
+  ClimateTraits get_traits();
+ protected:
+  virtual ClimateTraits traits() = 0;
+  virtual void control(const ClimateCall &call) = 0;
+};
+}}
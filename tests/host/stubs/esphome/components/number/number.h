@@ -0,0 +1,12 @@
+#pragma once
+#include "esphome/core/component.h"
+namespace esphome { namespace number {
+class Number : public EntityBase {
+ public:
+  void publish_state(float state);
+  float state;
+  bool has_state() const;
+ protected:
+  virtual void control(float value) = 0;
+};
+}}
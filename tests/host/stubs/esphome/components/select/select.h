@@ -0,0 +1,15 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "esphome/core/component.h"
+namespace esphome { namespace select {
+class SelectTraits { public: void set_options(std::vector<std::string> options); };
+class Select : public EntityBase {
+ public:
+  SelectTraits traits;
+  void publish_state(const std::string &state);
+  std::string state;
+ protected:
+  virtual void control(const std::string &value) = 0;
+};
+}}
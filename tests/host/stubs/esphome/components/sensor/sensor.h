@@ -0,0 +1,14 @@
+#pragma once
+#include <functional>
+#include "esphome/core/component.h"
+#include "esphome/core/helpers.h"
+namespace esphome { namespace sensor {
+class Sensor : public EntityBase {
+ public:
+  void publish_state(float state);
+  bool has_state() const;
+  float state;
+  float get_state() const;
+  void add_on_state_callback(std::function<void(float)> &&callback);
+};
+}}
@@ -0,0 +1,10 @@
+#pragma once
+#include <string>
+#include "esphome/core/component.h"
+namespace esphome { namespace text_sensor {
+class TextSensor : public EntityBase {
+ public:
+  void publish_state(const std::string &state);
+  std::string state;
+};
+}}
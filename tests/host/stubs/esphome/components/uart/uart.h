@@ -0,0 +1,20 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include "esphome/core/component.h"
+namespace esphome { namespace uart {
+class UARTComponent {
+ public:
+  virtual ~UARTComponent() = default;
+  void write_array(const std::vector<uint8_t> &data) { write_array(data.data(), data.size()); }
+  void write_byte(uint8_t data) { write_array(&data, 1); }
+  virtual void write_array(const uint8_t *data, size_t len) = 0;
+  virtual bool read_array(uint8_t *data, size_t len) = 0;
+  bool read_byte(uint8_t *data) { return read_array(data, 1); }
+  virtual bool peek_byte(uint8_t *data) = 0;
+  virtual int available() = 0;
+  virtual void flush() = 0;
+  uint32_t get_baud_rate() const { return 9600; }
+};
+}}
@@ -0,0 +1,36 @@
+#pragma once
+#include <functional>
+#include <vector>
+#include <string>
+#include "esphome/core/component.h"
+#include "esphome/core/helpers.h"
+namespace esphome {
+template<typename T, typename... X> class TemplatableValue {
+ public:
+  TemplatableValue() {}
+  TemplatableValue(T v) : v_(v), has_(true) {}
+  template<typename F> TemplatableValue(F f) : f_(f), has_(true), is_f_(true) {}
+  bool has_value() const { return has_; }
+  T value(X... x) { return is_f_ ? f_(x...) : v_; }
+ private:
+  T v_{}; std::function<T(X...)> f_; bool has_{false}; bool is_f_{false};
+};
+#define TEMPLATABLE_VALUE_(type, name) \
+ protected: TemplatableValue<type, Ts...> name##_{}; \
+ public: template<typename V> void set_##name(V name) { this->name##_ = name; }
+#define TEMPLATABLE_VALUE(type, name) TEMPLATABLE_VALUE_(type, name)
+template<typename... Ts> class Trigger {
+ public:
+  void trigger(Ts... x) { (void)sizeof...(x); }
+};
+template<typename... Ts> class Action {
+ public:
+  virtual ~Action() = default;
+ protected:
+  virtual void play(Ts... x) = 0;
+};
+template<typename... Ts> class Condition {
+ public:
+  virtual bool check(Ts... x) = 0;
+};
+}
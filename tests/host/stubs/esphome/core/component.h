@@ -0,0 +1,28 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <functional>
+#include "esphome/core/log.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/optional.h"
+namespace esphome {
+namespace setup_priority { extern const float DATA; extern const float LATE; extern const float BUS; extern const float AFTER_WIFI;}
+class Component {
+ public:
+  virtual void setup() {}
+  virtual void loop() {}
+  virtual void dump_config() {}
+  virtual void on_shutdown() {}
+  virtual float get_setup_priority() const { return 0; }
+  void mark_failed() {}
+ protected:
+  void set_interval(const std::string &name, uint32_t interval, std::function<void()> &&f);
+  void set_timeout(const std::string &name, uint32_t timeout, std::function<void()> &&f);
+  bool cancel_timeout(const std::string &name);
+};
+class EntityBase {
+ public:
+  const char *get_name() const;
+  std::string get_object_id() const;
+};
+}
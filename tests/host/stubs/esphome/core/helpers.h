@@ -0,0 +1,28 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <functional>
+#include "esphome/core/optional.h"
+namespace esphome {
+uint32_t fnv1_hash(const std::string &str);
+template<typename... Ts> class CallbackManager;
+template<typename... Ts> class CallbackManager<void(Ts...)> {
+ public:
+  void add(std::function<void(Ts...)> &&cb) { callbacks_.push_back(std::move(cb)); }
+  void call(Ts... args) { for (auto &cb : callbacks_) cb(args...); }
+  size_t size() const { return callbacks_.size(); }
+ protected:
+  std::vector<std::function<void(Ts...)>> callbacks_;
+};
+template<typename T> class Parented {
+ public:
+  Parented() {}
+  Parented(T *parent) : parent_(parent) {}
+  T *get_parent() const { return parent_; }
+  void set_parent(T *parent) { parent_ = parent; }
+ protected:
+  T *parent_{nullptr};
+};
+template<typename T> T clamp(T v, T lo, T hi) { return v < lo ? lo : (v > hi ? hi : v); }
+}
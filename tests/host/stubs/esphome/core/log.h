@@ -0,0 +1,14 @@
+#pragma once
+// Host-Stub: Logausgaben werden verworfen, die Formatstrings aber weiter geprüft
+namespace esphome {
+__attribute__((format(printf, 1, 2))) inline void esp_log_discard(const char *, ...) {}
+}  // namespace esphome
+#define ESP_LOGE(tag, ...) ((void) (tag), ::esphome::esp_log_discard(__VA_ARGS__))
+#define ESP_LOGW(tag, ...) ((void) (tag), ::esphome::esp_log_discard(__VA_ARGS__))
+#define ESP_LOGI(tag, ...) ((void) (tag), ::esphome::esp_log_discard(__VA_ARGS__))
+#define ESP_LOGD(tag, ...) ((void) (tag), ::esphome::esp_log_discard(__VA_ARGS__))
+#define ESP_LOGV(tag, ...) ((void) (tag), ::esphome::esp_log_discard(__VA_ARGS__))
+#define ESP_LOGVV(tag, ...) ((void) (tag), ::esphome::esp_log_discard(__VA_ARGS__))
+#define ESP_LOGCONFIG(tag, ...) ((void) (tag), ::esphome::esp_log_discard(__VA_ARGS__))
+#define LOG_SENSOR(prefix, type, obj) (void) (obj)
+#define LOG_TEXT_SENSOR(prefix, type, obj) (void) (obj)
@@ -0,0 +1,15 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+namespace esphome {
+class ESPPreferenceObject {
+ public:
+  template<typename T> bool save(const T *src) { (void)src; return true; }
+  template<typename T> bool load(T *dest) { (void)dest; return false; }
+};
+class ESPPreferences {
+ public:
+  template<typename T> ESPPreferenceObject make_preference(uint32_t type, bool in_flash = false) { (void)type; (void)in_flash; return {}; }
+};
+extern ESPPreferences *global_preferences;
+}
@@ -0,0 +1,10 @@
+#pragma once
+#include <cstdint>
+#include <ctime>
+namespace esphome {
+struct ESPTime {
+  uint8_t second; uint8_t minute; uint8_t hour; uint8_t day_of_week; uint8_t day_of_month;
+  uint16_t day_of_year; uint8_t month; uint16_t year; bool is_dst; time_t timestamp;
+  bool is_valid() const { return year >= 2019; }
+};
+}
@@ -0,0 +1,81 @@
+// Minimale Host-Implementierungen der ESPHome-Stubs für die Host-Tests
+#include "esphome/core/component.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/preferences.h"
+#include "esphome/components/climate/climate.h"
+#include "esphome/components/number/number.h"
+#include "esphome/components/select/select.h"
+#include "esphome/components/sensor/sensor.h"
+#include "esphome/components/text_sensor/text_sensor.h"
+
+namespace esphome {
+
+uint32_t host_millis = 0;
+
+uint32_t millis() { return host_millis; }
+uint32_t micros() { return host_millis * 1000; }
+void delay(uint32_t) {}
+void delayMicroseconds(uint32_t) {}
+
+uint32_t fnv1_hash(const std::string &str) {
+  uint32_t hash = 2166136261u;
+  for (char c : str) {
+    hash *= 16777619u;
+    hash ^= static_cast<uint8_t>(c);
+  }
+  return hash;
+}
+
+ESPPreferences *global_preferences = nullptr;
+
+const char *EntityBase::get_name() const { return "host"; }
+
+namespace sensor {
+void Sensor::publish_state(float value) { state = value; }
+bool Sensor::has_state() const { return false; }
+void Sensor::add_on_state_callback(std::function<void(float)> &&) {}
+}  // namespace sensor
+
+namespace text_sensor {
+void TextSensor::publish_state(const std::string &value) { state = value; }
+}  // namespace text_sensor
+
+namespace number {
+void Number::publish_state(float value) { state = value; }
+}  // namespace number
+
+namespace select {
+void SelectTraits::set_options(std::vector<std::string>) {}
+void Select::publish_state(const std::string &value) { state = value; }
+}  // namespace select
+
+namespace climate {
+void ClimateTraits::set_supported_modes(std::set<ClimateMode>) {}
+void ClimateTraits::set_supported_custom_presets(std::set<std::string>) {}
+void ClimateTraits::set_supported_custom_fan_modes(std::set<std::string>) {}
+void ClimateTraits::set_visual_min_temperature(float) {}
+void ClimateTraits::set_visual_max_temperature(float) {}
+void ClimateTraits::set_visual_temperature_step(float) {}
+void ClimateTraits::set_supports_current_temperature(bool) {}
+void Climate::publish_state() {}
+ClimateCall Climate::make_call() { return ClimateCall(this); }
+void ClimateCall::perform() {}
+ClimateCall &ClimateCall::set_mode(ClimateMode) { return *this; }
+ClimateCall &ClimateCall::set_target_temperature(float) { return *this; }
+ClimateCall &ClimateCall::set_preset(const std::string &) { return *this; }
+ClimateCall &ClimateCall::set_fan_mode(const std::string &) { return *this; }
+
+static const optional<ClimateMode> NO_MODE;
+static const optional<float> NO_FLOAT;
+static const optional<ClimateFanMode> NO_FAN_MODE;
+static const optional<ClimatePreset> NO_PRESET;
+static const optional<std::string> NO_STRING;
+const optional<ClimateMode> &ClimateCall::get_mode() const { return NO_MODE; }
+const optional<float> &ClimateCall::get_target_temperature() const { return NO_FLOAT; }
+const optional<ClimateFanMode> &ClimateCall::get_fan_mode() const { return NO_FAN_MODE; }
+const optional<std::string> &ClimateCall::get_custom_fan_mode() const { return NO_STRING; }
+const optional<ClimatePreset> &ClimateCall::get_preset() const { return NO_PRESET; }
+const optional<std::string> &ClimateCall::get_custom_preset() const { return NO_STRING; }
+}  // namespace climate
+
+}  // namespace esphome
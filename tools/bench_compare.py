@@ -0,0 +1,84 @@
+#!/usr/bin/env python3
+"""Vergleicht zwei Benchmark-Ergebnisse von autoterm_uart.benchmark.
+
+Eingabe sind ESPHome-Logs (Zeile "BENCH {...}") oder reine JSON-Dateien.
+Beispiel:
+
+    esphome logs air2d.yaml | tee neu.log
+    python3 tools/bench_compare.py alt.log neu.log --threshold 10
+
+Exit-Code 1, wenn eine Kennzahl um mehr als --threshold Prozent schlechter ist.
+"""
+import argparse
+import json
+import re
+import sys
+
+BENCH_RE = re.compile(r"BENCH (\{.*\})")
+
+# Kennzahl -> True, wenn größer besser ist; verschachtelte Werte als "gruppe.wert"
+METRICS = {
+    "crc_ns_per_frame": False,
+    "decode_ns_per_frame": False,
+    "framing_ns_per_byte": False,
+    "replay_ns_per_frame": False,
+    "replay_frames_per_s": True,
+    "parse_status.ns": False,
+    "parse_settings.ns": False,
+    "thermostat.ns": False,
+}
+
+
+def flatten(result, prefix=""):
+    flat = {}
+    for key, value in result.items():
+        if isinstance(value, dict):
+            flat.update(flatten(value, f"{prefix}{key}."))
+        else:
+            flat[f"{prefix}{key}"] = value
+    return flat
+
+
+def load(path):
+    with open(path, encoding="utf-8", errors="replace") as f:
+        text = f.read()
+    matches = BENCH_RE.findall(text)
+    # Bei mehreren Läufen im Log zählt der letzte
+    return flatten(json.loads(matches[-1] if matches else text))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("baseline")
+    parser.add_argument("candidate")
+    parser.add_argument("--threshold", type=float, default=10.0, help="erlaubte Verschlechterung in Prozent")
+    args = parser.parse_args()
+
+    base = load(args.baseline)
+    cand = load(args.candidate)
+    regressions = 0
+    print(f"{'Kennzahl':<26}{'Basis':>12}{'Neu':>12}{'Änderung':>11}")
+    for key, higher_is_better in METRICS.items():
+        if key not in base or key not in cand:
+            continue
+        # Live-Messungen ohne Aufrufe (z. B. Thermostat aus) sind nicht vergleichbar
+        group = key.rpartition(".")[0]
+        if group and (base.get(f"{group}.n") == 0 or cand.get(f"{group}.n") == 0):
+            continue
+        old, new = base[key], cand[key]
+        if old == 0:
+            # Von null aus ist jede Zunahme eine Verschlechterung (z. B. erste Allokation)
+            change = 0.0 if new == 0 else float("inf")
+        else:
+            change = (new - old) * 100.0 / old
+        worse = -change if higher_is_better else change
+        flag = ""
+        if worse > args.threshold:
+            flag = "  REGRESSION"
+            regressions += 1
+        print(f"{key:<26}{old:>12}{new:>12}{change:>+10.1f}%{flag}")
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,120 @@
+#!/usr/bin/env python3
+"""Empfängt die UDP-Telemetrie von autoterm_uart und schreibt sie als CSV.
+
+Beispiel:
+
+    python3 tools/telemetry_receiver.py --port 5555 -o brenner.csv
+
+Jeder Datensatz wird eine Zeile. Lücken in der Sequenznummer (verworfene oder
+verlorene Datagramme) werden auf stderr gemeldet; ein Neustart des ESP
+(Sequenz springt zurück) ebenfalls.
+"""
+import argparse
+import csv
+import socket
+import struct
+import sys
+import time
+
+MAGIC = b"AT"
+VERSION = 1
+HEADER = struct.Struct("<2sBBI")
+RECORD = struct.Struct("<IIBBHhhhhHHHHBBBBBBBB")
+TEMP_INVALID = -32768
+
+FLAG_CACHED = 0x01
+FLAG_STATUS_VALID = 0x02
+FLAG_SETTINGS_VALID = 0x04
+FLAG_RUNNING = 0x08
+FLAG_DISPLAY = 0x10
+
+COLUMNS = [
+    "received", "seq", "millis", "frame", "cached", "running", "display",
+    "status", "internal_c", "external_c", "heater_c", "panel_c", "voltage_v",
+    "fan_set_rpm", "fan_actual_rpm", "pump_hz", "fault",
+    "level", "set_temp_c", "temp_source", "wait_mode", "use_work_time", "work_time", "device_id",
+]
+
+
+def temp(value_dc):
+    return "" if value_dc == TEMP_INVALID else f"{value_dc / 10:.1f}"
+
+
+def decode(datagram):
+    """Liefert (bisher verworfen, [Datensatz-Tupel]) oder löst ValueError aus."""
+    if len(datagram) < HEADER.size:
+        raise ValueError("zu kurz")
+    magic, version, count, dropped = HEADER.unpack_from(datagram)
+    if magic != MAGIC or version != VERSION:
+        raise ValueError(f"unbekannter Kopf {magic!r} v{version}")
+    if len(datagram) != HEADER.size + count * RECORD.size:
+        raise ValueError(f"Länge {len(datagram)} passt nicht zu {count} Datensätzen")
+    return dropped, [RECORD.unpack_from(datagram, HEADER.size + i * RECORD.size) for i in range(count)]
+
+
+def row(received, rec):
+    (seq, millis, frame, flags, status, internal, external, heater, panel, voltage,
+     fan_set, fan_actual, pump, fault, level, set_temp, source, wait_mode, use_work_time, work_time, device_id) = rec
+    status_valid = flags & FLAG_STATUS_VALID
+    settings_valid = flags & FLAG_SETTINGS_VALID
+    return [
+        f"{received:.3f}", seq, millis, f"0x{frame:02X}", int(bool(flags & FLAG_CACHED)),
+        int(bool(flags & FLAG_RUNNING)), int(bool(flags & FLAG_DISPLAY)),
+        f"{status >> 8}.{status & 0xFF}" if status_valid else "",
+        temp(internal) if status_valid else "", temp(external) if status_valid else "",
+        temp(heater) if status_valid else "", temp(panel),
+        f"{voltage / 10:.1f}" if status_valid else "",
+        fan_set if status_valid else "", fan_actual if status_valid else "",
+        f"{pump / 100:.2f}" if status_valid else "", fault if status_valid else "",
+        *((level, set_temp, source, wait_mode, use_work_time, work_time) if settings_valid else [""] * 6),
+        "" if device_id == 0xFF else f"0x{device_id:02X}",
+    ]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--bind", default="0.0.0.0")
+    parser.add_argument("--port", type=int, default=5555)
+    parser.add_argument("-o", "--output", help="CSV-Datei (Standard: stdout)")
+    parser.add_argument("--count", type=int, default=0, help="nach N Datensätzen beenden (0 = endlos)")
+    args = parser.parse_args()
+
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    sock.bind((args.bind, args.port))
+    out = open(args.output, "a", newline="", encoding="utf-8") if args.output else sys.stdout
+    writer = csv.writer(out)
+    if out is sys.stdout or out.tell() == 0:
+        writer.writerow(COLUMNS)
+
+    expected = None
+    written = 0
+    try:
+        while args.count == 0 or written < args.count:
+            datagram, peer = sock.recvfrom(2048)
+            received = time.time()
+            try:
+                dropped, records = decode(datagram)
+            except ValueError as err:
+                print(f"{peer[0]}: Datagramm verworfen ({err})", file=sys.stderr)
+                continue
+            for rec in records:
+                seq = rec[0]
+                if expected is not None and seq != expected:
+                    if seq < expected:
+                        print(f"{peer[0]}: Sequenz neu ab {seq} (Neustart?)", file=sys.stderr)
+                    else:
+                        print(f"{peer[0]}: {seq - expected} Datensätze fehlen "
+                              f"(Gerät meldet {dropped} verworfen)", file=sys.stderr)
+                expected = seq + 1
+                writer.writerow(row(received, rec))
+                written += 1
+            out.flush()
+    except KeyboardInterrupt:
+        pass
+    finally:
+        if out is not sys.stdout:
+            out.close()
+
+
+if __name__ == "__main__":
+    main()